@@ -0,0 +1,155 @@
+// Frame-throughput benchmark for the animation engine, run on the host with
+// `pio run -e bench -t exec`. Each mode is driven through the real HTTP
+// handler and `loop()`, on a virtual clock so animation progress is the same
+// from one run to the next.
+#include <Arduino.h>
+#include <ESP8266WebServer.h>
+#include <NeoPixelAnimator.h>
+
+#include "FrameScheduler.h"
+#include "MultiPixelBus.h"
+
+#include <chrono>
+#include <stdio.h>
+
+void setup();
+void loop();
+void benchKernels();
+void benchHttp();
+void benchPresent();
+void benchShaders();
+void benchDither();
+
+extern NeoPixelAnimator animations;
+extern ESP8266WebServer server;
+extern PoleStrip strip;
+extern FrameScheduler scheduler;
+
+namespace
+{
+    // time given to each loop() besides the (emulated) wire time of Show()
+    const uint32_t FrameStepMicros = 1000;
+    const uint32_t FrameCount = 20000;
+
+    struct Scenario
+    {
+        const char *Name;
+        const char *Prepare; // request settled before measuring, may be null
+        const char *Trigger; // request that starts the animation
+        bool OneShot;        // fade: replay Prepare + Trigger once it completes
+    };
+
+    const Scenario scenarios[] = {
+        {"IDLE", "/?off", nullptr, false},
+        {"color", "/?color=000000", "/?color=ff8800", true},
+        {"randomcolor", "/?off", "/?randomcolor", true},
+        {"off", "/?color=ffffff", "/?off", true},
+        {"GYRO", "/?off", "/?mode=GYRO", false},
+        {"VERTICAL", "/?off", "/?mode=VERTICAL", false},
+        {"GYRO1", "/?off", "/?mode=GYRO1", false},
+        {"RAINBOW", "/?off", "/?mode=RAINBOW", false},
+        {"RAINBOW2", "/?off", "/?mode=RAINBOW2", false},
+        {"STRIPES", "/?off", "/?mode=STRIPES", false},
+        {"PLASMA", "/?off", "/?mode=PLASMA", false},
+        {"SPIRAL", "/?off", "/?mode=SPIRAL", false},
+        {"NOISE", "/?off", "/?mode=NOISE", false},
+    };
+
+    typedef std::chrono::steady_clock Clock;
+
+    void settle()
+    {
+        // stops the running modes and lets the fades complete
+        for (uint32_t guard = 0; animations.IsAnimating() && guard < 100000; guard++)
+        {
+            NativeHost::AdvanceClock(FrameStepMicros);
+            animations.UpdateAnimations();
+        }
+    }
+
+    void start(const Scenario &scenario)
+    {
+        if (scenario.Prepare)
+        {
+            server.Request(scenario.Prepare);
+            settle();
+        }
+        if (scenario.Trigger)
+        {
+            server.Request(scenario.Trigger);
+        }
+        // the settling above is not frame time
+        scheduler.Reset();
+    }
+
+    void restartIfDone(const Scenario &scenario)
+    {
+        if (scenario.OneShot && !animations.IsAnimating())
+        {
+            start(scenario);
+        }
+    }
+
+    // returns the total host time spent in `step`, in ns
+    template <typename T_STEP>
+    double measure(const Scenario &scenario, T_STEP step)
+    {
+        start(scenario);
+        Clock::duration total = Clock::duration::zero();
+        for (uint32_t frame = 0; frame < FrameCount; frame++)
+        {
+            restartIfDone(scenario);
+            NativeHost::AdvanceClock(FrameStepMicros);
+
+            Clock::time_point begin = Clock::now();
+            step();
+            total += Clock::now() - begin;
+        }
+        return std::chrono::duration<double, std::nano>(total).count();
+    }
+}
+
+int main()
+{
+    NativeHost::UseVirtualClock(true);
+    NativeHost::MuteSerial(true);
+    setup();
+
+    printf("%u pixels on %u output(s), %u us on the wire per push\n\n", strip.PixelCount(), strip.OutputCount(),
+           strip.LargestOutputPixelCount() * 30);
+
+    // frames/s is what the host CPU could render back to back, frames are
+    // paced by the scheduler in loop() so only a fraction of the calls render
+    printf("%-12s %12s %12s %12s %16s %8s %8s %8s\n",
+           "mode", "frames/s", "ns/frame", "ns/loop", "ns/UpdateAnim", "pushed", "skipped", "dropped");
+    for (const Scenario &scenario : scenarios)
+    {
+        uint32_t rendered = scheduler.FramesRendered();
+        uint32_t dropped = scheduler.FramesDropped();
+        uint32_t pushed = strip.FramesPushed();
+        uint32_t skipped = strip.FramesSkipped();
+        double loopNanos = measure(scenario, []() { loop(); });
+        rendered = scheduler.FramesRendered() - rendered;
+        dropped = scheduler.FramesDropped() - dropped;
+        pushed = strip.FramesPushed() - pushed;
+        skipped = strip.FramesSkipped() - skipped;
+
+        double updateNanos = measure(scenario, []() { animations.UpdateAnimations(); }) / FrameCount;
+        double frameNanos = loopNanos / (rendered ? rendered : 1);
+
+        printf("%-12s %12.0f %12.0f %12.0f %16.0f %8u %8u %8u\n", scenario.Name, 1e9 / frameNanos, frameNanos,
+               loopNanos / FrameCount, updateNanos, pushed, skipped, dropped);
+    }
+
+    printf("\n");
+    benchKernels();
+    printf("\n");
+    benchHttp();
+    printf("\n");
+    benchPresent();
+    printf("\n");
+    benchShaders();
+    printf("\n");
+    benchDither();
+    return 0;
+}
@@ -0,0 +1,53 @@
+// What the temporal dithering costs in Present(): the frame conversion with
+// the fractions carried from push to push, against the rounded one. Every
+// frame changes, the wire is left busy so only the conversion is measured.
+#include <Arduino.h>
+#include <NeoPixelBus.h>
+
+#include <chrono>
+#include <stdio.h>
+
+#include "MultiPixelBus.h"
+
+extern PoleStrip strip;
+
+namespace
+{
+    const uint32_t FrameCount = 20000;
+
+    typedef std::chrono::steady_clock Clock;
+
+    double nanosPerPresent(bool dithering)
+    {
+        strip.SetDithering(dithering);
+        Clock::time_point begin = Clock::now();
+        for (uint32_t frame = 0; frame < FrameCount; frame++)
+        {
+            // a fade of the whole frame, one level per frame
+            strip.ClearTo(RgbColor(frame & 0xff, (frame >> 1) & 0xff, 0));
+            strip.Present();
+        }
+        Clock::time_point end = Clock::now();
+        return std::chrono::duration<double, std::nano>(end - begin).count() / FrameCount;
+    }
+}
+
+void benchDither()
+{
+    uint8_t brightness = strip.GetBrightness();
+    strip.SetBrightness(10);
+
+    double rounded = nanosPerPresent(false);
+    double dithered = nanosPerPresent(true);
+    printf("%-16s %12s\n", "Present", "ns/frame");
+    printf("%-16s %12.0f\n", "rounded", rounded);
+    printf("%-16s %12.0f\n", "dithered", dithered);
+
+    strip.SetDithering(false);
+    strip.SetBrightness(brightness);
+    while (strip.Staged())
+    {
+        NativeHost::AdvanceClock(1000);
+        strip.Flush();
+    }
+}
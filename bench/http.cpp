@@ -0,0 +1,48 @@
+// Hammers the HTTP endpoints through the in-process server and reports the
+// heap still in use afterwards: the handlers write their replies into a
+// fixed buffer, so after a warm-up the heap must not grow.
+#include <Arduino.h>
+#include <ESP8266WebServer.h>
+
+#include <chrono>
+#include <malloc.h>
+#include <stdio.h>
+
+extern ESP8266WebServer server;
+
+namespace
+{
+    const uint32_t WarmUp = 100;
+    const uint32_t Requests = 20000;
+
+    typedef std::chrono::steady_clock Clock;
+
+    size_t heapInUse()
+    {
+        return mallinfo2().uordblks;
+    }
+}
+
+void benchHttp()
+{
+    const char *targets[] = {"/", "/?brightness=128", "/?color=ff8800", "/memory", "/schedule", "/index.html"};
+
+    printf("%-20s %12s %12s\n", "request", "us/request", "heap growth");
+    for (const char *target : targets)
+    {
+        for (uint32_t request = 0; request < WarmUp; request++)
+        {
+            server.Request(target);
+        }
+        size_t before = heapInUse();
+        Clock::time_point begin = Clock::now();
+        for (uint32_t request = 0; request < Requests; request++)
+        {
+            server.Request(target);
+        }
+        Clock::time_point end = Clock::now();
+        long growth = (long)heapInUse() - (long)before;
+        printf("%-20s %12.2f %12ld\n", target,
+               std::chrono::duration<double, std::micro>(end - begin).count() / Requests, growth);
+    }
+}
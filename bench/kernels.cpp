@@ -0,0 +1,94 @@
+// Float vs fixed-point easing and blending kernels, one call per pixel as
+// the animations do. The host has an FPU, the ESP8266 does not: the ratios
+// printed here are a lower bound of the gain on the pole.
+#include <Arduino.h>
+#include <NeoPixelBus.h>
+
+#include <chrono>
+#include <stdio.h>
+
+#include "FixedPoint.h"
+#include "Palette.h"
+
+namespace
+{
+    const uint32_t Iterations = 2000000;
+
+    typedef std::chrono::steady_clock Clock;
+
+    volatile uint32_t sink;
+
+    template <typename T_KERNEL>
+    double nanosPerCall(T_KERNEL kernel)
+    {
+        uint32_t accumulator = 0;
+        Clock::time_point begin = Clock::now();
+        for (uint32_t iteration = 0; iteration < Iterations; iteration++)
+        {
+            accumulator += kernel(iteration);
+        }
+        Clock::time_point end = Clock::now();
+        sink = accumulator;
+        return std::chrono::duration<double, std::nano>(end - begin).count() / Iterations;
+    }
+
+    void compare(const char *name, double floatNanos, double fixedNanos)
+    {
+        printf("%-16s %12.2f %12.2f %10.1fx\n", name, floatNanos, fixedNanos, floatNanos / fixedNanos);
+    }
+
+    template <typename T_FLOAT_EASE>
+    void compareEase(const char *name, T_FLOAT_EASE floatEase, const Fixed::EaseCurve &curve)
+    {
+        double floatNanos = nanosPerCall([&](uint32_t i) {
+            return (uint32_t)(floatEase((i & 0xffff) / 65535.0f) * 65535.0f);
+        });
+        double fixedNanos = nanosPerCall([&](uint32_t i) {
+            return (uint32_t)Fixed::Ease(curve, (Fixed::Progress)i);
+        });
+        compare(name, floatNanos, fixedNanos);
+    }
+}
+
+void benchKernels()
+{
+    printf("%-16s %12s %12s %11s\n", "kernel", "ns float", "ns fixed", "speedup");
+
+    compareEase("QuadraticOut", NeoEase::QuadraticOut, Fixed::QuadraticOut);
+    compareEase("CubicInOut", NeoEase::CubicInOut, Fixed::CubicInOut);
+    compareEase("ExponentialOut", NeoEase::ExponentialOut, Fixed::ExponentialOut);
+
+    RgbColor left(255, 128, 0);
+    RgbColor right(0, 64, 255);
+    double floatNanos = nanosPerCall([&](uint32_t i) {
+        RgbColor color = RgbColor::LinearBlend(left, right, (i & 0xff) / 255.0f);
+        return (uint32_t)color.R + color.G + color.B;
+    });
+    double fixedNanos = nanosPerCall([&](uint32_t i) {
+        RgbColor color = Fixed::LinearBlend(left, right, i & 0xff);
+        return (uint32_t)color.R + color.G + color.B;
+    });
+    compare("LinearBlend", floatNanos, fixedNanos);
+
+    floatNanos = nanosPerCall([&](uint32_t i) {
+        float progress = NeoEase::ExponentialOut((i & 0xffff) / 65535.0f);
+        RgbColor color = RgbColor::LinearBlend(left, right, progress);
+        return (uint32_t)color.R + color.G + color.B;
+    });
+    fixedNanos = nanosPerCall([&](uint32_t i) {
+        uint16_t weight = Fixed::Weight(Fixed::Ease(Fixed::ExponentialOut, (Fixed::Progress)i));
+        RgbColor color = Fixed::LinearBlend(left, right, weight);
+        return (uint32_t)color.R + color.G + color.B;
+    });
+    compare("fade pixel", floatNanos, fixedNanos);
+
+    floatNanos = nanosPerCall([&](uint32_t i) {
+        RgbColor color = HslColor((i & 0xff) / 256.0f, 1.0f, 0.5f);
+        return (uint32_t)color.R + color.G + color.B;
+    });
+    fixedNanos = nanosPerCall([&](uint32_t i) {
+        RgbColor color = Palette::Hue(i);
+        return (uint32_t)color.R + color.G + color.B;
+    });
+    compare("hue", floatNanos, fixedNanos);
+}
@@ -0,0 +1,88 @@
+// Show() vs Present() on the emulated DMA wire, with the render time of a
+// frame simulated on the virtual clock. Both keep the wire busy, the frame
+// period is max(render, wire) either way; what Present() changes is the
+// time loop() spends blocked in the push, which goes to the network instead.
+#include <Arduino.h>
+#include <NeoPixelBus.h>
+
+#include <stdio.h>
+
+#include "MultiPixelBus.h"
+
+extern PoleStrip strip;
+
+namespace
+{
+    const uint32_t FrameCount = 200;
+    // what one loop() without a frame to render costs, spent waiting on the wire
+    const uint32_t NetworkStepMicros = 50;
+
+    // renders a frame that differs from the previous one
+    void render(uint32_t renderMicros, uint32_t frame)
+    {
+        NativeHost::AdvanceClock(renderMicros);
+        strip.ClearTo(RgbColor(frame & 1 ? 255 : 0, 0, 0));
+    }
+
+    struct Result
+    {
+        uint32_t FrameMicros;
+        uint32_t BlockedMicros;
+    };
+
+    Result blocking(uint32_t renderMicros)
+    {
+        uint32_t blocked = 0;
+        uint32_t begin = micros();
+        for (uint32_t frame = 0; frame < FrameCount; frame++)
+        {
+            render(renderMicros, frame);
+            uint32_t push = micros();
+            strip.Show();
+            blocked += micros() - push;
+        }
+        return {(micros() - begin) / FrameCount, blocked / FrameCount};
+    }
+
+    Result presented(uint32_t renderMicros)
+    {
+        uint32_t blocked = 0;
+        uint32_t begin = micros();
+        uint32_t pushed = strip.FramesPushed();
+        for (uint32_t frame = 0; frame < FrameCount;)
+        {
+            uint32_t push = micros();
+            strip.Flush();
+            blocked += micros() - push;
+            if (strip.Staged())
+            {
+                NativeHost::AdvanceClock(NetworkStepMicros);
+                continue;
+            }
+            render(renderMicros, frame++);
+            push = micros();
+            strip.Present();
+            blocked += micros() - push;
+        }
+        while (strip.Staged())
+        {
+            NativeHost::AdvanceClock(NetworkStepMicros);
+            strip.Flush();
+        }
+        pushed = strip.FramesPushed() - pushed;
+        return {(micros() - begin) / pushed, blocked / pushed};
+    }
+}
+
+void benchPresent()
+{
+    printf("%-10s %14s %14s %14s %14s\n", "render us", "Show us/frame", "blocked us", "Present us", "blocked us");
+    const uint32_t renderMicros[] = {1000, 4000, 7000, 10000};
+    for (uint32_t render : renderMicros)
+    {
+        Result show = blocking(render);
+        Result present = presented(render);
+        printf("%-10u %14u %14u %14u %14u\n", render, show.FrameMicros, show.BlockedMicros, present.FrameMicros,
+               present.BlockedMicros);
+    }
+}
@@ -0,0 +1,107 @@
+// The shaders rendering whole frames on a layer, and PLASMA written the
+// obvious way with float sines and HslColor for comparison. The host has an
+// FPU, the ESP8266 does not: the float column is a lower bound of what it
+// would cost on the pole.
+//
+// A frame must render in under 1 ms on the ESP8266, which is not measured
+// here: the device columns are an estimate from the host time. On the pole,
+// the frame shows in ledpole_phase_max_seconds{phase="animations"} of
+// /metrics while the mode runs.
+#include <Arduino.h>
+#include <NeoPixelAnimator.h>
+#include <NeoPixelBus.h>
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+
+#include "effects/Shaders.h"
+
+namespace
+{
+    const uint32_t FrameCount = 20000;
+    // ms between two frames, 60 frames/s
+    const uint32_t FrameMillis = 16;
+
+    // the frame budget on the pole
+    const double BudgetMicros = 1000.0;
+    // estimated slowdown of the LX106 at 80 MHz against a ~3 GHz host core:
+    // at most one instruction per cycle instead of several, and the tables
+    // read through the flash cache; 160 MHz halves it. A guess on the safe
+    // side, not a measurement
+    const double DeviceSlowdown80MHz = 100.0;
+
+    typedef std::chrono::steady_clock Clock;
+
+    template <typename T_RENDER>
+    double nanosPerFrame(T_RENDER render)
+    {
+        Clock::time_point begin = Clock::now();
+        for (uint32_t frame = 0; frame < FrameCount; frame++)
+        {
+            render(frame * FrameMillis);
+        }
+        Clock::time_point end = Clock::now();
+        return std::chrono::duration<double, std::nano>(end - begin).count() / FrameCount;
+    }
+
+    template <typename T_EFFECT>
+    double nanosPerShaderFrame(PoleLayer &canvas, NeoPixelAnimator &animations)
+    {
+        const EffectContext context = {canvas, animations, 0};
+        T_EFFECT effect(context);
+        return nanosPerFrame([&](uint32_t time) { effect.Render(time); });
+    }
+
+    void floatPlasma(PoleLayer &canvas, uint32_t time)
+    {
+        const float turn = 6.2831853f;
+        for (uint8_t row = 0; row < Pole::RowCount; row++)
+        {
+            float height = (float)row / Pole::ColumnCount;
+            for (uint8_t column = 0; column < Pole::ColumnCount; column++)
+            {
+                float angle = (float)column / Pole::ColumnCount;
+                float sum = sinf(turn * (angle * 2 + time / 2816.0f)) + sinf(turn * (height + time / 4352.0f)) +
+                            sinf(turn * (angle + height / 2 - time / 5888.0f));
+                float hue = time / 16384.0f + sum / 4.0f;
+                canvas.SetPixelColor(Pole::Index(row, column), HslColor(hue - floorf(hue), 1.0f, 0.5f));
+            }
+        }
+    }
+}
+
+void benchShaders()
+{
+    PoleLayer canvas;
+    NeoPixelAnimator animations(1);
+
+    printf("%-12s %12s %12s %14s %14s %14s\n", "shader", "ns/frame", "ns/pixel", "frames/s", "est. us@80MHz",
+           "est. us@160MHz");
+    struct
+    {
+        const char *Name;
+        double Nanos;
+    } results[] = {
+        {"PLASMA", nanosPerShaderFrame<PlasmaEffect>(canvas, animations)},
+        {"SPIRAL", nanosPerShaderFrame<RainbowSpiralEffect>(canvas, animations)},
+        {"NOISE", nanosPerShaderFrame<NoiseFlowEffect>(canvas, animations)},
+        {"PLASMA float", nanosPerFrame([&](uint32_t time) { floatPlasma(canvas, time); })},
+    };
+    bool withinBudget = true;
+    for (const auto &result : results)
+    {
+        // ns on the host, times the slowdown, in us
+        double micros80 = result.Nanos * DeviceSlowdown80MHz / 1000.0;
+        printf("%-12s %12.0f %12.1f %14.0f %14.0f %14.0f\n", result.Name, result.Nanos,
+               result.Nanos / Pole::PixelCount, 1e9 / result.Nanos, micros80, micros80 / 2);
+        if (&result != &results[3])
+        {
+            withinBudget = withinBudget && micros80 < BudgetMicros;
+        }
+    }
+    printf("PLASMA fixed point is %.1fx faster than float\n", results[3].Nanos / results[0].Nanos);
+    printf("ESP8266 budget %.0f us/frame: %s at 80 MHz by the estimate (%.0fx slower than the host), "
+           "not measured on the device\n",
+           BudgetMicros, withinBudget ? "within" : "OVER", DeviceSlowdown80MHz);
+}
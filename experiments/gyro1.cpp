@@ -14,16 +14,19 @@
 #include <NeoPixelBus.h>
 #include <NeoPixelAnimator.h>
 
-const uint8_t PixelCount = 240; // make sure to set this to the number of pixels in your strip
+#include "Palette.h"
+#include "PoleGeometry.h"
+
+const uint16_t PixelCount = Pole::PixelCount; // make sure to set this to the number of pixels in your strip
 const uint8_t PixelPin = 2;     // make sure to set this to the correct pin, ignored for Esp8266
-const uint8_t PixelPerRow = 16;
-const uint8_t RowCount = 15;
+const uint8_t PixelPerRow = Pole::ColumnCount;
+const uint8_t RowCount = Pole::RowCount;
 const uint8_t AnimCount = PixelPerRow / 5 * 2 + 1; // we only need enough animations for the tail and one extra
 const uint16_t PixelFadeDuration = 200;            // third of a second
 // one second divide by the number of pixels = loop once a second
 const uint16_t NextPixelMoveDuration = 700 / PixelPerRow; // how fast we move through the pixels
 
-const float intensity = 0.15f;
+const uint8_t intensity = 76; // value of the hue, what the HSL lightness 15% gave
 
 NeoGamma<NeoGammaTableMethod> colorGamma; // for any fade animations, best to correct gamma
 
@@ -67,20 +70,6 @@ void SetRandomSeed()
     randomSeed(seed);
 }
 
-// retourne l'index d'un pixel à partir d'un `rowIndex` et `colIndex`
-uint8_t getPixelIndex(uint8_t rowIndex, uint8_t colIndex)
-{
-    return (rowIndex * PixelPerRow) + colIndex;
-}
-
-// retourne l'index d'un pixel à partir d'un `rowIndex` et `colIndex`
-// en inversant une ligne sur deux (assemblage zig-zag)
-uint8_t getNormalizedPixelIndex(uint8_t rowIndex, uint8_t colIndex)
-{
-    const uint8_t offset = rowIndex % 2 == 1 ? PixelPerRow - colIndex - 1 : colIndex;
-    return (rowIndex * PixelPerRow) + offset;
-}
-
 void FadeOutAnimUpdate(const AnimationParam &param)
 {
     // this gets called for each animation on every time step
@@ -94,7 +83,7 @@ void FadeOutAnimUpdate(const AnimationParam &param)
     // apply the color to the strip
     for (uint8_t row = 0; row < RowCount; row++)
     {
-        strip.SetPixelColor(getNormalizedPixelIndex(row, animationState[param.index].IndexPixel),
+        strip.SetPixelColor(Pole::Index(row, animationState[param.index].IndexPixel),
                             colorGamma.Correct(updatedColor));
     }
 }
@@ -114,7 +103,7 @@ void LoopAnimUpdate(const AnimationParam &param)
         if (frontPixel == 0)
         {
             // we looped, lets pick a new front color
-            frontColor = HslColor(random(360) / 360.0f, 1.0f, intensity);
+            frontColor = Palette::RandomHue(intensity);
         }
 
         uint16_t indexAnim;
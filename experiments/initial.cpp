@@ -2,6 +2,9 @@
 #include <NeoPixelBrightnessBus.h>
 #include <NeoPixelAnimator.h>
 
+#include "Palette.h"
+#include "PoleGeometry.h"
+
 #include <ESP8266WiFi.h>
 #include <WiFiClient.h>
 #include <ESP8266WebServer.h>
@@ -14,11 +17,11 @@ const char *password = "xxx";
 ESP8266WebServer server(80);
 
 // Total number of pixels
-const uint8_t PixelCount = 240;
+const uint16_t PixelCount = Pole::PixelCount;
 
 // geometry for a zig-zag soldering
-const uint8_t PixelPerRow = 16;
-const uint8_t RowCount = 15;
+const uint8_t PixelPerRow = Pole::ColumnCount;
+const uint8_t RowCount = Pole::RowCount;
 
 // some colors
 const RgbColor black = RgbColor(0, 0, 0);
@@ -85,22 +88,16 @@ void allumeLigne(uint16_t rowIndex, RgbColor color)
     for (int count = 0; count < PixelPerRow; count += 1)
     {
         // applique la couleur au pixel
-        strip.SetPixelColor((rowIndex * PixelPerRow) + count, color);
+        strip.SetPixelColor(Pole::Index(rowIndex, count), color);
     }
 }
 
-// retourne l'index d'un pixel à partir d'un `rowIndex` et `colIndex`
-int getPixelIndex(uint8_t rowIndex, uint8_t colIndex)
-{
-    return (rowIndex * PixelPerRow) + colIndex;
-}
-
 // allume la colonne `colIndex` avec la couleur `color`
 void allumeColonne(uint8_t colIndex, RgbColor color)
 {
     for (int count = 0; count < RowCount; count += 1)
     {
-        strip.SetPixelColor(getPixelIndex(count, colIndex), color);
+        strip.SetPixelColor(Pole::Index(count, colIndex), color);
     }
 }
 
@@ -120,7 +117,7 @@ void fadeRow(uint8_t rowIndex, uint16_t duration, RgbColor color)
 {
     for (int count = 0; count < PixelPerRow; count += 1)
     {
-        uint8_t pixel = getPixelIndex(rowIndex, count);
+        uint16_t pixel = Pole::Index(rowIndex, count);
         colorAnimationState[pixel].StartingColor = black;
         colorAnimationState[pixel].EndingColor = color;
         animations.StartAnimation(pixel, duration, FadeColorUpdate);
@@ -141,7 +138,7 @@ void colorize(RgbColor color)
 // anime toutes les leds vers une couleur
 void fadeAll(RgbColor color, uint32_t duration = 300)
 {
-    for (uint8_t pixel = 0; pixel < strip.PixelCount(); pixel += 1)
+    for (uint16_t pixel = 0; pixel < strip.PixelCount(); pixel += 1)
     {
         colorAnimationState[pixel].StartingColor = strip.GetPixelColor(pixel);
         colorAnimationState[pixel].EndingColor = color;
@@ -161,7 +158,7 @@ void handleRequest()
     }
     else if (server.hasArg("randomcolor"))
     {
-        RgbColor randomColor = HslColor(random(360) / 360.0f, 1.0f, 0.5f);
+        RgbColor randomColor = Palette::RandomHue();
         Serial.println("Set random color");
         colorize(randomColor);
     }
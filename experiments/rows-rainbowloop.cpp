@@ -15,16 +15,19 @@
 #include <NeoPixelBrightnessBus.h>
 #include <NeoPixelAnimator.h>
 
-const uint8_t PixelCount = 240; // make sure to set this to the number of pixels in your strip
+#include "Palette.h"
+#include "PoleGeometry.h"
+
+const uint16_t PixelCount = Pole::PixelCount; // make sure to set this to the number of pixels in your strip
 const uint8_t PixelPin = 2;     // make sure to set this to the correct pin, ignored for Esp8266
-const uint8_t PixelPerRow = 16;
-const uint8_t RowCount = 15;
+const uint8_t PixelPerRow = Pole::ColumnCount;
+const uint8_t RowCount = Pole::RowCount;
 const uint8_t AnimCount = 2;           //PixelPerRow / 5 * 2 + 1; // we only need enough animations for the tail and one extra
 const uint16_t PixelFadeDuration = 50; // third of a second
 // one second divide by the number of pixels = loop once a second
 const uint16_t NextRowMoveDuration = 100; // how fast we move through the rows
 
-const float intensity = 0.5f;
+const uint8_t intensity = 255; // value of the hue, what the HSL lightness 50% gave
 
 NeoGamma<NeoGammaTableMethod> colorGamma; // for any fade animations, best to correct gamma
 
@@ -72,20 +75,6 @@ void SetRandomSeed()
     randomSeed(seed);
 }
 
-// retourne l'index d'un pixel à partir d'un `rowIndex` et `colIndex`
-uint8_t getPixelIndex(uint8_t rowIndex, uint8_t colIndex)
-{
-    return (rowIndex * PixelPerRow) + colIndex;
-}
-
-// retourne l'index d'un pixel à partir d'un `rowIndex` et `colIndex`
-// en inversant une ligne sur deux (assemblage zig-zag)
-uint8_t getNormalizedPixelIndex(uint8_t rowIndex, uint8_t colIndex)
-{
-    const uint8_t offset = rowIndex % 2 == 1 ? PixelPerRow - colIndex - 1 : colIndex;
-    return (rowIndex * PixelPerRow) + offset;
-}
-
 void RowFadeInUpdate(const AnimationParam &param)
 {
     // this gets called for each animation on every time step
@@ -100,7 +89,7 @@ void RowFadeInUpdate(const AnimationParam &param)
     for (uint8_t col = 0; col < PixelPerRow; col++)
     {
 
-        strip.SetPixelColor(getNormalizedPixelIndex(animationState[param.index].RowIndex, col), colorGamma.Correct(updatedColor));
+        strip.SetPixelColor(Pole::Index(animationState[param.index].RowIndex, col), colorGamma.Correct(updatedColor));
     }
 }
 
@@ -118,7 +107,7 @@ void LoopAnimUpdate(const AnimationParam &param)
         // done, time to restart this position tracking animation/timer
         animations.RestartAnimation(param.index);
 
-        RgbColor color = RgbColor(HslColor(random(360) / 360.0f, 1.0f, intensity));
+        RgbColor color = Palette::RandomHue(intensity);
 
         //Serial.println("color");
         //Serial.println(String(color));
@@ -133,9 +122,9 @@ void LoopAnimUpdate(const AnimationParam &param)
         {
 
             // Serial.println("NextAvailableAnimation");
-            animationState[indexAnim].StartingColor = strip.GetPixelColor(getNormalizedPixelIndex(row - 1, 0));
+            animationState[indexAnim].StartingColor = strip.GetPixelColor(Pole::Index((row + RowCount - 1) % RowCount, 0));
             animationState[indexAnim].EndingColor = color;
-            animationState[indexAnim].RowIndex = row - 1;
+            animationState[indexAnim].RowIndex = (row + RowCount - 1) % RowCount;
 
             animations.StartAnimation(indexAnim, PixelFadeDuration, RowFadeInUpdate);
         }
@@ -151,8 +140,8 @@ void setup()
     /*
     for (uint8_t row = 0; row < RowCount; row++)
     {
-        RgbColor color = HslColor(random(360) / 360.0f, 1.0f, intensity);
-        strip.SetPixelColor(getNormalizedPixelIndex(row, 5), color);
+        RgbColor color = Palette::RandomHue(intensity);
+        strip.SetPixelColor(Pole::Index(row, 5), color);
     }
 
     //  strip.SetPixelColor(42, RgbColor(255, 0, 0));
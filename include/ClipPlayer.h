@@ -0,0 +1,350 @@
+#pragma once
+
+#include <Arduino.h>
+#include <FS.h>
+#include <NeoPixelBus.h>
+
+// Clip files: frames of the pole rendered beforehand, encoded by
+// tools/clip_encode.py and stored in LittleFS.
+//
+// header, 16 bytes, little endian:
+//   "LPC1", rows, columns, fps, 0, frame count (u16), keyframe interval (u16), 0 (u32)
+// then one record per frame:
+//   type (u8), payload length (u16), payload
+// Record_Key holds the whole frame, Record_Delta the changes from the
+// previous one; every frame whose index is a multiple of the keyframe
+// interval is a key, the others can be too.
+// The payload is a list of runs over the pixels, rows from the bottom and
+// columns from the left as in the DDP stream:
+//   0x00-0x3f  skip n+1 pixels, they keep their colour (deltas only)
+//   0x40-0x7f  n+1 pixels follow, 3 bytes each (R, G, B)
+//   0x80-0xff  n+1 pixels of the colour that follows
+// Colours are linear, gamma and brightness are applied by the strip.
+namespace Clip
+{
+    const size_t HeaderSize = 16;
+    const size_t RecordHeaderSize = 3;
+
+    enum RecordType
+    {
+        Record_Key = 'K',
+        Record_Delta = 'D'
+    };
+
+    enum Run
+    {
+        Run_Skip = 0x00,
+        Run_Literal = 0x40,
+        Run_Repeat = 0x80
+    };
+
+    struct Header
+    {
+        uint8_t Rows;
+        uint8_t Columns;
+        uint8_t Fps;
+        uint16_t FrameCount;
+        uint16_t KeyframeInterval;
+
+        bool Parse(const uint8_t *bytes)
+        {
+            if (memcmp(bytes, "LPC1", 4) != 0)
+            {
+                return false;
+            }
+            Rows = bytes[4];
+            Columns = bytes[5];
+            Fps = bytes[6];
+            FrameCount = bytes[8] | bytes[9] << 8;
+            KeyframeInterval = bytes[10] | bytes[11] << 8;
+            return Fps > 0 && FrameCount > 0 && KeyframeInterval > 0;
+        }
+    };
+}
+
+// Plays a clip file on T_CANVAS (the bus or a layer) at the clip's own
+// frame rate. Frames are streamed from the file through a small ring
+// buffer and decoded in place over the previous frame, so the clip is
+// never loaded in RAM. When loop() falls behind, the frames up to the last
+// keyframe due are skipped without being decoded.
+template <typename T_CANVAS, typename T_GEOMETRY>
+class ClipPlayer
+{
+public:
+    static const uint16_t RingSize = 512;
+
+    ClipPlayer(T_CANVAS &canvas) : _canvas(canvas)
+    {
+    }
+
+    // reads the header of `file`, false when it is not a clip of this pole
+    static bool ReadHeader(File &file, Clip::Header *header)
+    {
+        uint8_t bytes[Clip::HeaderSize];
+        return file.read(bytes, sizeof(bytes)) == sizeof(bytes) && header->Parse(bytes) &&
+               header->Rows == T_GEOMETRY::RowCount && header->Columns == T_GEOMETRY::ColumnCount;
+    }
+
+    // plays `file` from its first frame, `now` in ms
+    bool Start(File file, uint32_t now)
+    {
+        _file = file;
+        _playing = _file && ReadHeader(_file, &_header);
+        if (!_playing)
+        {
+            _file.close();
+            return false;
+        }
+        Rewind();
+        _start = now;
+        return true;
+    }
+
+    void Stop()
+    {
+        _file.close();
+        _playing = false;
+    }
+
+    // false when nothing plays, or the clip stopped on a damaged frame
+    bool IsPlaying() const
+    {
+        return _playing;
+    }
+
+    const Clip::Header &GetHeader() const
+    {
+        return _header;
+    }
+
+    // index of the next frame to decode
+    uint16_t Frame() const
+    {
+        return _frame;
+    }
+
+    // decodes the frames due at `now`, the clip loops; returns true when
+    // the canvas changed
+    bool Handle(uint32_t now)
+    {
+        if (!_playing)
+        {
+            return false;
+        }
+
+        uint32_t due = (uint64_t)(now - _start) * _header.Fps / 1000;
+        if (due < _frame)
+        {
+            return false;
+        }
+        if (due >= _header.FrameCount)
+        {
+            // the clip ended, start over from its first keyframe
+            _start += (uint64_t)_header.FrameCount * 1000 / _header.Fps;
+            due -= _header.FrameCount;
+            Rewind();
+            if (due >= _header.FrameCount)
+            {
+                // more than a whole clip behind, e.g. after a DDP stream
+                _start = now;
+                due = 0;
+            }
+        }
+
+        uint16_t lastKey = due - due % _header.KeyframeInterval;
+        while (_frame < lastKey)
+        {
+            if (!SkipRecord())
+            {
+                return Fail();
+            }
+        }
+        while (_frame <= due)
+        {
+            if (!DecodeRecord())
+            {
+                return Fail();
+            }
+        }
+        return true;
+    }
+
+private:
+    void Rewind()
+    {
+        _file.seek(Clip::HeaderSize);
+        _head = 0;
+        _count = 0;
+        _frame = 0;
+    }
+
+    bool Fail()
+    {
+        Stop();
+        return false;
+    }
+
+    // reads as much of the file as fits after the buffered bytes
+    void Fill()
+    {
+        uint16_t tail = (_head + _count) % RingSize;
+        uint16_t space = tail >= _head && _count < RingSize ? RingSize - tail : _head - tail;
+        if (space > 0)
+        {
+            _count += _file.read(_ring + tail, space);
+        }
+    }
+
+    bool ReadByte(uint8_t *value)
+    {
+        if (_count == 0)
+        {
+            Fill();
+            if (_count == 0)
+            {
+                return false;
+            }
+        }
+        *value = _ring[_head];
+        _head = (_head + 1) % RingSize;
+        _count--;
+        return true;
+    }
+
+    bool ReadColor(RgbColor *color)
+    {
+        return ReadByte(&color->R) && ReadByte(&color->G) && ReadByte(&color->B);
+    }
+
+    bool ReadRecordHeader(uint8_t *type, uint16_t *length)
+    {
+        // a frame is read at once from a buffer at least half full
+        if (_count < RingSize / 2)
+        {
+            Fill();
+        }
+        uint8_t low;
+        uint8_t high;
+        if (!ReadByte(type) || !ReadByte(&low) || !ReadByte(&high))
+        {
+            return false;
+        }
+        *length = low | high << 8;
+        return *type == Clip::Record_Key || *type == Clip::Record_Delta;
+    }
+
+    bool SkipRecord()
+    {
+        uint8_t type;
+        uint16_t length;
+        if (!ReadRecordHeader(&type, &length))
+        {
+            return false;
+        }
+        if (length <= _count)
+        {
+            _head = (_head + length) % RingSize;
+            _count -= length;
+        }
+        else
+        {
+            // the rest of the record is not buffered yet, jump over it
+            length -= _count;
+            _head = 0;
+            _count = 0;
+            if (!_file.seek(_file.position() + length))
+            {
+                return false;
+            }
+        }
+        _frame++;
+        return true;
+    }
+
+    bool DecodeRecord()
+    {
+        uint8_t type;
+        uint16_t length;
+        if (!ReadRecordHeader(&type, &length))
+        {
+            return false;
+        }
+        // a key must cover every pixel, with no skip
+        const bool key = type == Clip::Record_Key;
+        uint16_t pixel = 0;
+        while (length > 0)
+        {
+            uint8_t run;
+            if (!ReadByte(&run))
+            {
+                return false;
+            }
+            length--;
+            uint16_t count = (run & (run & Clip::Run_Repeat ? 0x7f : 0x3f)) + 1;
+            if (pixel + count > T_GEOMETRY::PixelCount)
+            {
+                return false;
+            }
+
+            if (run & Clip::Run_Repeat)
+            {
+                RgbColor color;
+                if (length < 3 || !ReadColor(&color))
+                {
+                    return false;
+                }
+                length -= 3;
+                for (uint16_t end = pixel + count; pixel < end; pixel++)
+                {
+                    SetPixel(pixel, color);
+                }
+            }
+            else if (run & Clip::Run_Literal)
+            {
+                if (length < count * 3)
+                {
+                    return false;
+                }
+                length -= count * 3;
+                for (uint16_t end = pixel + count; pixel < end; pixel++)
+                {
+                    RgbColor color;
+                    if (!ReadColor(&color))
+                    {
+                        return false;
+                    }
+                    SetPixel(pixel, color);
+                }
+            }
+            else if (key)
+            {
+                return false;
+            }
+            else
+            {
+                pixel += count;
+            }
+        }
+        if (key && pixel != T_GEOMETRY::PixelCount)
+        {
+            return false;
+        }
+        _frame++;
+        return true;
+    }
+
+    void SetPixel(uint16_t pixel, RgbColor color)
+    {
+        _canvas.SetPixelColor(T_GEOMETRY::Index(pixel / T_GEOMETRY::ColumnCount, pixel % T_GEOMETRY::ColumnCount), color);
+    }
+
+    T_CANVAS &_canvas;
+    File _file;
+    Clip::Header _header = {};
+    bool _playing = false;
+    uint32_t _start = 0;
+    uint16_t _frame = 0;
+    uint8_t _ring[RingSize];
+    uint16_t _head = 0;
+    uint16_t _count = 0;
+};
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <NeoPixelBus.h>
+
+// Binary messages of the WebSocket control channel (port 81). Each message
+// is an opcode byte followed by its arguments, 16 bit values are big endian:
+//
+//   0x01 color        R G B        fade to the color
+//   0x02 brightness   B
+//   0x03 mode         index        in the order of `PoleMode`, BOOT excluded
+//   0x04 param        id hi lo     see `ControlParam`
+//   0x05 randomcolor
+//   0x06 off
+//   0x07 status                    asks for a status message
+//
+// The pole answers and pushes on change:
+//
+//   0x80 status       mode brightness fps_hi fps_lo flags   (flags: 1 = live)
+//
+// and a text message {"error":"unknown command"} to an unknown or truncated
+// message, {"error":"unknown mode"} to a mode index out of `PoleMode`
+namespace Control
+{
+    enum Opcode : uint8_t
+    {
+        Opcode_Color = 0x01,
+        Opcode_Brightness = 0x02,
+        Opcode_Mode = 0x03,
+        Opcode_Param = 0x04,
+        Opcode_RandomColor = 0x05,
+        Opcode_Off = 0x06,
+        Opcode_Status = 0x07,
+        Opcode_StatusReply = 0x80
+    };
+
+    enum Param : uint8_t
+    {
+        Param_Fps,
+        Param_Count
+    };
+
+    // The commands received since they were last applied: only the latest
+    // of each kind is kept, so a slider drag sending many messages between
+    // two frames costs a single change.
+    struct Commands
+    {
+        enum Kind : uint8_t
+        {
+            Pending_Color = 0x01,
+            Pending_RandomColor = 0x02,
+            Pending_Off = 0x04,
+            Pending_Brightness = 0x08,
+            Pending_Mode = 0x10,
+            Pending_Fps = 0x20,
+            Pending_Status = 0x40,
+            // the commands that replace the whole frame, the latest wins
+            Pending_Frame = Pending_Color | Pending_RandomColor | Pending_Off | Pending_Mode
+        };
+
+        uint8_t Pending = 0;
+        RgbColor Color = RgbColor(0);
+        uint8_t Brightness = 0;
+        uint8_t Mode = 0;
+        uint16_t Fps = 0;
+
+        // merges one message, returns false if it is unknown or truncated
+        bool Parse(const uint8_t *payload, size_t length)
+        {
+            if (length == 0)
+            {
+                return false;
+            }
+            switch (payload[0])
+            {
+            case Opcode_Color:
+                if (length < 4)
+                {
+                    return false;
+                }
+                Color = RgbColor(payload[1], payload[2], payload[3]);
+                SetFrame(Pending_Color);
+                return true;
+            case Opcode_Brightness:
+                if (length < 2)
+                {
+                    return false;
+                }
+                Brightness = payload[1];
+                Pending |= Pending_Brightness;
+                return true;
+            case Opcode_Mode:
+                if (length < 2)
+                {
+                    return false;
+                }
+                Mode = payload[1];
+                SetFrame(Pending_Mode);
+                return true;
+            case Opcode_Param:
+                if (length < 4 || payload[1] >= Param_Count)
+                {
+                    return false;
+                }
+                // Param_Fps is the only parameter so far
+                Fps = ((uint16_t)payload[2] << 8) | payload[3];
+                Pending |= Pending_Fps;
+                return true;
+            case Opcode_RandomColor:
+                SetFrame(Pending_RandomColor);
+                return true;
+            case Opcode_Off:
+                SetFrame(Pending_Off);
+                return true;
+            case Opcode_Status:
+                Pending |= Pending_Status;
+                return true;
+            }
+            return false;
+        }
+
+        bool Has(Kind kind) const
+        {
+            return Pending & kind;
+        }
+
+    private:
+        void SetFrame(uint8_t pending)
+        {
+            Pending = (Pending & ~Pending_Frame) | pending;
+        }
+    };
+
+    // what the panel shows, pushed when it changes
+    struct Status
+    {
+        static const size_t Size = 6;
+        static const uint8_t Flags_Live = 0x01;
+
+        uint8_t Mode;
+        uint8_t Brightness;
+        uint16_t Fps;
+        uint8_t Flags;
+
+        void Write(uint8_t (&buffer)[Size]) const
+        {
+            buffer[0] = Opcode_StatusReply;
+            buffer[1] = Mode;
+            buffer[2] = Brightness;
+            buffer[3] = Fps >> 8;
+            buffer[4] = Fps & 0xff;
+            buffer[5] = Flags;
+        }
+
+        bool operator!=(const Status &other) const
+        {
+            return Mode != other.Mode || Brightness != other.Brightness || Fps != other.Fps || Flags != other.Flags;
+        }
+    };
+}
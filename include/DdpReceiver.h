@@ -0,0 +1,184 @@
+#pragma once
+
+#include <NeoPixelBus.h>
+#include <WiFiUdp.h>
+
+// Receives pixels from a show controller with DDP (Distributed Display
+// Protocol, http://www.3waylabs.com/ddp/), the protocol xLights, WLED or
+// Falcon Player speak on UDP 4048.
+//
+// - the data is read from the UDP buffer a few pixels at a time and set in
+//   the frame through T_GEOMETRY: the sender sees the pole as rows of
+//   ColumnCount pixels, from the bottom left, whatever the wiring
+// - packets carry a 4 bit sequence number (1..15, 0 when unused); a packet
+//   older than the last accepted one is dropped, duplicates are applied again
+// - the frame is pushed when a packet has the PUSH flag, so a frame split
+//   over several packets never shows half updated
+// - the receiver is live from the first packet until `LiveTimeout` ms
+//   without any, the firmware pauses its own effects meanwhile
+template <typename T_BUS, typename T_GEOMETRY>
+class DdpReceiver
+{
+public:
+    static const uint16_t Port = 4048;
+    static const uint16_t LiveTimeout = 2500;
+    // packets handled per call, so a flood doesn't starve the web server
+    static const uint8_t MaxPacketsPerHandle = 4;
+
+    DdpReceiver(T_BUS &bus, WiFiUDP &udp) : _bus(bus), _udp(udp)
+    {
+    }
+
+    bool Begin()
+    {
+        return _udp.begin(Port) == 1;
+    }
+
+    // reads the waiting packets, returns true when a frame was completed
+    bool Handle(uint32_t now)
+    {
+        bool pushed = false;
+        for (uint8_t count = 0; count < MaxPacketsPerHandle && _udp.parsePacket() > 0; count++)
+        {
+            if (HandlePacket(now))
+            {
+                pushed = true;
+            }
+        }
+        if (_live && now - _lastPacket > LiveTimeout)
+        {
+            // the sender is gone, a new one starts its own sequence
+            _live = false;
+            _lastSequence = 0;
+        }
+        return pushed;
+    }
+
+    bool IsLive() const
+    {
+        return _live;
+    }
+
+    uint32_t PacketsReceived() const
+    {
+        return _packetsReceived;
+    }
+
+    // out of order or malformed
+    uint32_t PacketsDropped() const
+    {
+        return _packetsDropped;
+    }
+
+private:
+    enum Flags
+    {
+        Flags_VersionMask = 0xc0,
+        Flags_Version1 = 0x40,
+        Flags_Timecode = 0x10,
+        Flags_Storage = 0x08,
+        Flags_Reply = 0x04,
+        Flags_Query = 0x02,
+        Flags_Push = 0x01
+    };
+
+    enum Destination
+    {
+        Destination_Display = 1,
+        Destination_All = 255
+    };
+
+    static const uint8_t HeaderSize = 10;
+    static const uint8_t TimecodeSize = 4;
+    static const uint8_t BytesPerPixel = 3;
+    // pixels copied per read from the UDP buffer
+    static const uint8_t ChunkPixels = 16;
+
+    bool HandlePacket(uint32_t now)
+    {
+        uint8_t header[HeaderSize];
+        if (_udp.read(header, HeaderSize) != HeaderSize ||
+            (header[0] & Flags_VersionMask) != Flags_Version1)
+        {
+            _packetsDropped++;
+            return false;
+        }
+        // queries, replies and storage or config destinations aren't supported
+        if ((header[0] & (Flags_Query | Flags_Reply | Flags_Storage)) ||
+            (header[3] != Destination_Display && header[3] != Destination_All))
+        {
+            return false;
+        }
+
+        uint8_t sequence = header[1] & 0x0f;
+        if (sequence != 0 && _lastSequence != 0)
+        {
+            // how far the packet is behind the last one, on the 1..15 cycle
+            uint8_t behind = (_lastSequence - sequence + 15) % 15;
+            if (behind != 0 && behind <= 7)
+            {
+                _packetsDropped++;
+                return false;
+            }
+        }
+
+        if (header[0] & Flags_Timecode)
+        {
+            uint8_t timecode[TimecodeSize];
+            _udp.read(timecode, TimecodeSize);
+        }
+
+        uint32_t offset = ((uint32_t)header[4] << 24) | ((uint32_t)header[5] << 16) |
+                          ((uint32_t)header[6] << 8) | header[7];
+        uint16_t length = ((uint16_t)header[8] << 8) | header[9];
+        if (offset % BytesPerPixel != 0)
+        {
+            _packetsDropped++;
+            return false;
+        }
+
+        _packetsReceived++;
+        _lastPacket = now;
+        _live = true;
+        if (sequence != 0)
+        {
+            _lastSequence = sequence;
+        }
+
+        uint32_t indexPixel = offset / BytesPerPixel;
+        uint16_t countPixels = length / BytesPerPixel;
+        uint8_t chunk[ChunkPixels * BytesPerPixel];
+        while (countPixels > 0 && indexPixel < T_GEOMETRY::PixelCount)
+        {
+            uint8_t count = min<uint32_t>(min<uint16_t>(countPixels, ChunkPixels), T_GEOMETRY::PixelCount - indexPixel);
+            int read = _udp.read(chunk, count * BytesPerPixel) / BytesPerPixel;
+            for (int index = 0; index < read; index++, indexPixel++)
+            {
+                const uint8_t *rgb = chunk + index * BytesPerPixel;
+                _bus.SetPixelColor(T_GEOMETRY::Index(indexPixel / T_GEOMETRY::ColumnCount, indexPixel % T_GEOMETRY::ColumnCount),
+                                   RgbColor(rgb[0], rgb[1], rgb[2]));
+            }
+            if (read < count)
+            {
+                // the packet is shorter than its header says
+                break;
+            }
+            countPixels -= count;
+        }
+
+        if (header[0] & Flags_Push)
+        {
+            _bus.Present();
+            return true;
+        }
+        return false;
+    }
+
+    T_BUS &_bus;
+    WiFiUDP &_udp;
+    bool _live = false;
+    uint8_t _lastSequence = 0;
+    uint32_t _lastPacket = 0;
+    uint32_t _packetsReceived = 0;
+    uint32_t _packetsDropped = 0;
+};
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <NeoPixelBus.h>
+#include <NeoPixelAnimator.h>
+
+#include "LayerCompositor.h"
+#include "Palette.h"
+#include "PoleGeometry.h"
+
+// what an effect draws on and animates with; the effect owns the animation
+// channels [FirstChannel, FirstChannel + its ChannelCount)
+struct EffectContext
+{
+    PoleLayer &Canvas;
+    NeoPixelAnimator &Animations;
+    uint16_t FirstChannel;
+};
+
+// An animation of the pole selectable with `?mode=`. Effects are built in
+// the shared EffectArena when their mode is entered and destroyed when it is
+// left, so only the active one holds state.
+//
+// Each effect declares the channels it needs in a static `ChannelCount`.
+// Channel 0 is the timer started by StartTimer(), Step() is called each time
+// it completes.
+class Effect
+{
+public:
+    Effect(const EffectContext &context, uint16_t channelCount)
+        : _context(context), _channelCount(channelCount)
+    {
+    }
+
+    virtual ~Effect()
+    {
+    }
+
+    virtual void Start() = 0;
+
+    // stops every channel of the effect, their callbacks point to it
+    void Stop()
+    {
+        for (uint16_t channel = 0; channel < _channelCount; channel++)
+        {
+            _context.Animations.StopAnimation(_context.FirstChannel + channel);
+        }
+    }
+
+protected:
+    virtual void Step()
+    {
+    }
+
+    void StartTimer(uint16_t duration)
+    {
+        StartChannel(0, duration, [this](const AnimationParam &param) {
+            // wait for this animation to complete,
+            // we are using it as a timer of sorts
+            if (param.state == AnimationState_Completed)
+            {
+                _context.Animations.RestartAnimation(param.index);
+                Step();
+            }
+        });
+    }
+
+    void StartChannel(uint16_t channel, uint16_t duration, AnimUpdateCallback update)
+    {
+        _context.Animations.StartAnimation(_context.FirstChannel + channel, duration, update);
+    }
+
+    // first idle channel of the effect from `from` on; if none is left the
+    // caller is going too fast for its ChannelCount and skips a step
+    bool NextAvailableChannel(uint16_t *channel, uint16_t from = 1) const
+    {
+        for (uint16_t index = from; index < _channelCount; index++)
+        {
+            if (!_context.Animations.IsAnimationActive(_context.FirstChannel + index))
+            {
+                *channel = index;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // channel of the effect an animation callback was called for
+    uint16_t ChannelOf(const AnimationParam &param) const
+    {
+        return param.index - _context.FirstChannel;
+    }
+
+    void FillRow(uint8_t row, RgbColor color)
+    {
+        for (uint8_t column = 0; column < Pole::ColumnCount; column++)
+        {
+            _context.Canvas.SetPixelColor(Pole::Index(row, column), color);
+        }
+    }
+
+    void FillColumn(uint8_t column, RgbColor color)
+    {
+        for (uint8_t row = 0; row < Pole::RowCount; row++)
+        {
+            _context.Canvas.SetPixelColor(Pole::Index(row, column), color);
+        }
+    }
+
+    // a random hue at full saturation, scaled by `value`
+    RgbColor RandomColor(uint8_t value = 255) const
+    {
+        return Palette::RandomHue(value);
+    }
+
+    const EffectContext _context;
+
+private:
+    const uint16_t _channelCount;
+};
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <algorithm>
+#include <new>
+
+#include "Effect.h"
+
+// The storage shared by all the effects listed in T_EFFECTS: it is as large
+// as the largest of them and holds the active one only, so adding an effect
+// costs its code and no RAM unless it is the biggest.
+template <typename... T_EFFECTS>
+class EffectArena
+{
+public:
+    static constexpr size_t Size = std::max({sizeof(T_EFFECTS)...});
+    // animation channels to reserve for whichever effect is active
+    static constexpr uint16_t ChannelCount = std::max({T_EFFECTS::ChannelCount...});
+
+    ~EffectArena()
+    {
+        Destroy();
+    }
+
+    // stops and destroys the active effect, then builds a `T_EFFECT` in its place
+    template <typename T_EFFECT>
+    Effect *Create(const EffectContext &context)
+    {
+        static_assert(sizeof(T_EFFECT) <= Size && alignof(T_EFFECT) <= alignof(Storage),
+                      "the effect isn't listed in the arena");
+        Destroy();
+        _active = new (&_storage) T_EFFECT(context);
+        return _active;
+    }
+
+    void Destroy()
+    {
+        if (_active)
+        {
+            _active->Stop();
+            _active->~Effect();
+            _active = nullptr;
+        }
+    }
+
+    Effect *Active() const
+    {
+        return _active;
+    }
+
+private:
+    struct alignas(T_EFFECTS...) Storage
+    {
+        uint8_t Bytes[Size];
+    };
+
+    Storage _storage;
+    Effect *_active = nullptr;
+};
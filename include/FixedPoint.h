@@ -0,0 +1,149 @@
+#pragma once
+
+#include <Arduino.h>
+#include <NeoPixelBus.h>
+
+// Integer replacements for the float easing and blending of NeoPixelBus:
+// the ESP8266 has no FPU, so every float operation is a library call.
+//
+// - progress is 0.16 fixed point: 0 is the start, 65535 the end
+// - blend weights go from 0 (left colour) to 256 (right colour)
+// - easing curves are 257 entry tables in flash, linearly interpolated
+namespace Fixed
+{
+    typedef uint16_t Progress;
+
+    static const Progress ProgressEnd = 65535;
+    static const uint16_t WeightEnd = 256;
+
+    // the only float operation left, once per tick and per animation channel
+    inline Progress FromUnit(float progress)
+    {
+        if (progress <= 0.0f)
+        {
+            return 0;
+        }
+        if (progress >= 1.0f)
+        {
+            return ProgressEnd;
+        }
+        return (Progress)(progress * ProgressEnd + 0.5f);
+    }
+
+    inline uint16_t Weight(Progress progress)
+    {
+        return ((uint32_t)progress + 128) >> 8;
+    }
+
+    inline uint8_t Lerp(uint8_t left, uint8_t right, uint16_t weight)
+    {
+        return left + (((int16_t)right - left) * (int32_t)weight >> 8);
+    }
+
+    inline RgbColor LinearBlend(const RgbColor &left, const RgbColor &right, uint16_t weight)
+    {
+        return RgbColor(Lerp(left.R, right.R, weight),
+                        Lerp(left.G, right.G, weight),
+                        Lerp(left.B, right.B, weight));
+    }
+
+    struct EaseCurve
+    {
+        uint16_t Values[257];
+    };
+
+    inline Progress Ease(const EaseCurve &curve, Progress progress)
+    {
+        uint8_t index = progress >> 8;
+        uint8_t fraction = progress & 0xff;
+        int32_t low = pgm_read_word(&curve.Values[index]);
+        int32_t high = pgm_read_word(&curve.Values[index + 1]);
+        return (Progress)(low + ((high - low) * fraction >> 8));
+    }
+
+    // the curves are computed by the compiler, the formulas are NeoEase's
+    namespace Curves
+    {
+        // e^x for x in [-8, 0]: Taylor series of x/16, squared four times
+        constexpr double Exp(double x)
+        {
+            double scaled = x / 16.0;
+            double term = 1.0;
+            double sum = 1.0;
+            for (int n = 1; n < 16; n++)
+            {
+                term *= scaled / n;
+                sum += term;
+            }
+            for (int square = 0; square < 4; square++)
+            {
+                sum *= sum;
+            }
+            return sum;
+        }
+
+        constexpr double Exp2(double x)
+        {
+            return Exp(x * 0.69314718055994530942);
+        }
+
+        // ln(x) for x in (0, 1]: halved into [0.5, 1), then the atanh series
+        constexpr double Ln(double x)
+        {
+            int halvings = 0;
+            while (x < 0.5)
+            {
+                x *= 2.0;
+                halvings++;
+            }
+            double z = (x - 1.0) / (x + 1.0);
+            double power = z;
+            double sum = 0.0;
+            for (int n = 0; n < 20; n++)
+            {
+                sum += power / (2 * n + 1);
+                power *= z * z;
+            }
+            return 2.0 * sum - halvings * 0.69314718055994530942;
+        }
+
+        template <typename T_FUNCTION>
+        constexpr EaseCurve Build(T_FUNCTION function)
+        {
+            EaseCurve curve = {};
+            for (int index = 0; index <= 256; index++)
+            {
+                double value = function(index / 256.0);
+                value = value < 0.0 ? 0.0 : value > 1.0 ? 1.0 : value;
+                curve.Values[index] = (uint16_t)(value * ProgressEnd + 0.5);
+            }
+            return curve;
+        }
+    }
+
+    inline constexpr EaseCurve QuadraticIn PROGMEM = Curves::Build([](double u) { return u * u; });
+    inline constexpr EaseCurve QuadraticOut PROGMEM = Curves::Build([](double u) { return -u * (u - 2.0); });
+    inline constexpr EaseCurve QuadraticInOut PROGMEM = Curves::Build([](double u) {
+        return u < 0.5 ? 2.0 * u * u : -0.5 * ((2.0 * u - 1.0) * (2.0 * u - 3.0) - 1.0);
+    });
+    inline constexpr EaseCurve CubicIn PROGMEM = Curves::Build([](double u) { return u * u * u; });
+    inline constexpr EaseCurve CubicOut PROGMEM = Curves::Build([](double u) {
+        return (u - 1.0) * (u - 1.0) * (u - 1.0) + 1.0;
+    });
+    inline constexpr EaseCurve CubicInOut PROGMEM = Curves::Build([](double u) {
+        return u < 0.5 ? 4.0 * u * u * u : 0.5 * ((2.0 * u - 2.0) * (2.0 * u - 2.0) * (2.0 * u - 2.0) + 2.0);
+    });
+    inline constexpr EaseCurve ExponentialIn PROGMEM = Curves::Build([](double u) {
+        return Curves::Exp2(10.0 * (u - 1.0)) - 0.001;
+    });
+    inline constexpr EaseCurve ExponentialOut PROGMEM = Curves::Build([](double u) {
+        return 1.0 - Curves::Exp2(-10.0 * u);
+    });
+
+    // the gamma of NeoGammaEquationMethod, u^(1/0.45), with 16 bit of
+    // output where NeoGammaTableMethod keeps 8: Ease(Gamma, value * 257)
+    // for a value 0..255
+    inline constexpr EaseCurve Gamma PROGMEM = Curves::Build([](double u) {
+        return u <= 0.0 ? 0.0 : Curves::Exp(Curves::Ln(u) / 0.45);
+    });
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Fixed-timestep frame clock: frames are due on a regular grid of
+// 1/fps seconds. When loop() falls behind, the missed grid points are
+// dropped instead of being rendered in a burst, so animations keep their
+// pace; the time left before the next frame goes to network work.
+class FrameScheduler
+{
+public:
+    static const uint16_t MinFps = 1;
+    // a 240 pixels WS2812 frame takes 7.2ms on the wire
+    static const uint16_t MaxFps = 120;
+
+    FrameScheduler(uint16_t fps)
+    {
+        SetFps(fps);
+    }
+
+    void SetFps(uint16_t fps)
+    {
+        _fps = fps < MinFps ? MinFps : fps > MaxFps ? MaxFps : fps;
+        _period = 1000000UL / _fps;
+        Reset();
+    }
+
+    // restarts the grid from now, e.g. once setup() is done
+    void Reset()
+    {
+        _nextFrame = micros();
+    }
+
+    uint16_t Fps() const
+    {
+        return _fps;
+    }
+
+    // true once per period, at most one frame per call
+    bool FrameDue()
+    {
+        uint32_t now = micros();
+        uint32_t late = now - _nextFrame;
+        if ((int32_t)late < 0)
+        {
+            return false;
+        }
+
+        if (late >= _period)
+        {
+            // skip the frames we had no time for
+            uint32_t missed = late / _period;
+            _framesDropped += missed;
+            _nextFrame += missed * _period;
+            late -= missed * _period;
+        }
+        if (late >= _period / 2)
+        {
+            _framesLate++;
+        }
+        _nextFrame += _period;
+        _framesRendered++;
+
+        // frames per second over the last full second
+        _windowFrames++;
+        if (now - _windowStart >= 1000000UL)
+        {
+            _measuredFps = (uint64_t)_windowFrames * 1000000UL / (now - _windowStart);
+            _windowStart = now;
+            _windowFrames = 0;
+        }
+        return true;
+    }
+
+    // the rate frames were actually rendered at, lower than Fps() when
+    // loop() falls behind
+    uint16_t MeasuredFps() const
+    {
+        return _measuredFps;
+    }
+
+    uint32_t FramesRendered() const
+    {
+        return _framesRendered;
+    }
+
+    uint32_t FramesDropped() const
+    {
+        return _framesDropped;
+    }
+
+    // frames rendered half a period or more after their grid point
+    uint32_t FramesLate() const
+    {
+        return _framesLate;
+    }
+
+private:
+    uint16_t _fps;
+    uint32_t _period;
+    uint32_t _nextFrame;
+    uint32_t _framesRendered = 0;
+    uint32_t _framesDropped = 0;
+    uint32_t _framesLate = 0;
+    uint32_t _windowStart = 0;
+    uint16_t _windowFrames = 0;
+    uint16_t _measuredFps = 0;
+};
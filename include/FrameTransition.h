@@ -0,0 +1,81 @@
+#pragma once
+
+#include <NeoPixelBus.h>
+#include <NeoPixelAnimator.h>
+
+#include "FixedPoint.h"
+
+// Fades the whole frame from a snapshot of the bus towards a single colour
+// or a target frame. A single animation channel drives it: the easing is
+// computed once per tick and every pixel is blended in the same loop,
+// instead of one channel and one callback per pixel. Easing and blending
+// are integer only (FixedPoint.h).
+template <typename T_BUS, uint16_t T_PIXEL_COUNT>
+class FrameTransition
+{
+public:
+    typedef const Fixed::EaseCurve *EaseFunction;
+
+    FrameTransition(T_BUS &bus) : _bus(bus) {}
+
+    // fades every pixel towards `color`
+    void StartToColor(RgbColor color, EaseFunction ease = &Fixed::ExponentialOut)
+    {
+        Capture(ease);
+        _targetColor = color;
+        _toFrame = false;
+    }
+
+    // fades every pixel towards its entry in TargetFrame(), filled beforehand
+    void StartToFrame(EaseFunction ease = &Fixed::ExponentialOut)
+    {
+        Capture(ease);
+        _toFrame = true;
+    }
+
+    RgbColor *TargetFrame()
+    {
+        return _target;
+    }
+
+    // animation callback, progress goes from 0.0 to 1.0
+    void Update(const AnimationParam &param)
+    {
+        // the easing curves stop just short of 1.0, land exactly on the target
+        uint16_t weight = param.state == AnimationState_Completed
+                              ? Fixed::WeightEnd
+                              : Fixed::Weight(Fixed::Ease(*_ease, Fixed::FromUnit(param.progress)));
+
+        if (_toFrame)
+        {
+            for (uint16_t pixel = 0; pixel < T_PIXEL_COUNT; pixel++)
+            {
+                _bus.SetPixelColor(pixel, Fixed::LinearBlend(_start[pixel], _target[pixel], weight));
+            }
+        }
+        else
+        {
+            for (uint16_t pixel = 0; pixel < T_PIXEL_COUNT; pixel++)
+            {
+                _bus.SetPixelColor(pixel, Fixed::LinearBlend(_start[pixel], _targetColor, weight));
+            }
+        }
+    }
+
+private:
+    void Capture(EaseFunction ease)
+    {
+        for (uint16_t pixel = 0; pixel < T_PIXEL_COUNT; pixel++)
+        {
+            _start[pixel] = _bus.GetPixelColor(pixel);
+        }
+        _ease = ease;
+    }
+
+    T_BUS &_bus;
+    RgbColor _start[T_PIXEL_COUNT];
+    RgbColor _target[T_PIXEL_COUNT];
+    RgbColor _targetColor;
+    bool _toFrame = false;
+    EaseFunction _ease = &Fixed::ExponentialOut;
+};
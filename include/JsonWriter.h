@@ -0,0 +1,216 @@
+#pragma once
+
+#include <Arduino.h>
+#include <type_traits>
+
+// Writes a JSON document into a caller-owned buffer, without any heap
+// allocation:
+//
+//   JsonWriter json(buffer);
+//   json.BeginObject().Member("fps", 60).Member("status", "IDLE").EndObject();
+//   server.send(200, "application/json", json.c_str(), json.Length());
+//
+// What doesn't fit is dropped and Overflowed() tells it; the text is always
+// null terminated. Nesting is limited to MaxDepth levels, a document nested
+// deeper is marked Overflowed().
+class JsonWriter
+{
+public:
+    static const uint8_t MaxDepth = 32;
+
+    JsonWriter(char *buffer, size_t size) : _buffer(buffer), _size(size)
+    {
+        _buffer[0] = 0;
+    }
+
+    template <size_t N>
+    JsonWriter(char (&buffer)[N]) : JsonWriter(buffer, N)
+    {
+    }
+
+    JsonWriter &BeginObject(const char *key = nullptr)
+    {
+        Key(key);
+        return Open('{');
+    }
+
+    JsonWriter &EndObject()
+    {
+        return Close('}');
+    }
+
+    JsonWriter &BeginArray(const char *key = nullptr)
+    {
+        Key(key);
+        return Open('[');
+    }
+
+    JsonWriter &EndArray()
+    {
+        return Close(']');
+    }
+
+    JsonWriter &Member(const char *key, const char *value)
+    {
+        Key(key);
+        WriteString(value);
+        return *this;
+    }
+
+    JsonWriter &Member(const char *key, bool value)
+    {
+        Key(key);
+        Write(value ? "true" : "false");
+        return *this;
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value, JsonWriter &>::type
+    Member(const char *key, T value)
+    {
+        Key(key);
+        if (std::is_signed<T>::value && value < (T)0)
+        {
+            Write('-');
+            WriteUnsigned(0 - (uint64_t)value);
+        }
+        else
+        {
+            WriteUnsigned((uint64_t)value);
+        }
+        return *this;
+    }
+
+    JsonWriter &MemberNull(const char *key)
+    {
+        Key(key);
+        Write("null");
+        return *this;
+    }
+
+    const char *c_str() const
+    {
+        return _buffer;
+    }
+
+    size_t Length() const
+    {
+        return _length;
+    }
+
+    bool Overflowed() const
+    {
+        return _overflowed;
+    }
+
+private:
+    // writes the separator and the key, if any, of the next value
+    void Key(const char *key)
+    {
+        if (_needComma & DepthBit())
+        {
+            Write(',');
+        }
+        _needComma |= DepthBit();
+        if (key)
+        {
+            WriteString(key);
+            Write(':');
+        }
+    }
+
+    JsonWriter &Open(char c)
+    {
+        Write(c);
+        _depth++;
+        if (_depth > MaxDepth)
+        {
+            _overflowed = true;
+        }
+        _needComma &= ~DepthBit();
+        return *this;
+    }
+
+    JsonWriter &Close(char c)
+    {
+        _depth--;
+        Write(c);
+        return *this;
+    }
+
+    // the comma flag of the current level, none past MaxDepth
+    uint64_t DepthBit() const
+    {
+        return _depth <= MaxDepth ? 1ULL << _depth : 0;
+    }
+
+    void Write(char c)
+    {
+        if (_length + 1 < _size)
+        {
+            _buffer[_length++] = c;
+            _buffer[_length] = 0;
+        }
+        else
+        {
+            _overflowed = true;
+        }
+    }
+
+    void Write(const char *text)
+    {
+        while (*text)
+        {
+            Write(*text++);
+        }
+    }
+
+    void WriteUnsigned(uint64_t value)
+    {
+        char digits[20];
+        uint8_t count = 0;
+        do
+        {
+            digits[count++] = '0' + value % 10;
+            value /= 10;
+        } while (value > 0);
+        while (count > 0)
+        {
+            Write(digits[--count]);
+        }
+    }
+
+    void WriteString(const char *text)
+    {
+        static const char Hex[] = "0123456789abcdef";
+        Write('"');
+        for (; *text; text++)
+        {
+            uint8_t c = *text;
+            if (c == '"' || c == '\\')
+            {
+                Write('\\');
+                Write((char)c);
+            }
+            else if (c < 0x20)
+            {
+                Write("\\u00");
+                Write(Hex[c >> 4]);
+                Write(Hex[c & 0x0f]);
+            }
+            else
+            {
+                Write((char)c);
+            }
+        }
+        Write('"');
+    }
+
+    char *_buffer;
+    size_t _size;
+    size_t _length = 0;
+    uint8_t _depth = 0;
+    // bit n: the level n already holds a value, level 0 is the document
+    uint64_t _needComma = 0;
+    bool _overflowed = false;
+};
@@ -0,0 +1,268 @@
+#pragma once
+
+#include <NeoPixelBus.h>
+
+#include "FixedPoint.h"
+#include "PoleGeometry.h"
+
+// how a layer is laid over the layers below it, scaled by its opacity
+enum LayerBlend
+{
+    LayerBlend_Alpha,    // covers what is below
+    LayerBlend_Add,      // adds its light, black lets what is below through
+    LayerBlend_Multiply, // tints what is below, white lets it through
+};
+
+template <typename T_BUS, uint16_t T_PIXEL_COUNT, uint8_t T_LAYER_COUNT>
+class LayerCompositor;
+
+// A frame in linear colour that is drawn on like the bus (SetPixelColor,
+// GetPixelColor, ClearTo) and composed with the others by LayerCompositor.
+// An opacity of 0 hides the layer without losing its pixels.
+template <uint16_t T_PIXEL_COUNT>
+class Layer
+{
+public:
+    Layer(LayerBlend blend = LayerBlend_Alpha, uint8_t opacity = 255) : _blend(blend), _opacity(opacity)
+    {
+        ClearTo(RgbColor(0));
+    }
+
+    uint16_t PixelCount() const
+    {
+        return T_PIXEL_COUNT;
+    }
+
+    void SetPixelColor(uint16_t indexPixel, RgbColor color)
+    {
+        if (indexPixel < T_PIXEL_COUNT && _pixels[indexPixel] != color)
+        {
+            _pixels[indexPixel] = color;
+            _changed = true;
+        }
+    }
+
+    RgbColor GetPixelColor(uint16_t indexPixel) const
+    {
+        return indexPixel < T_PIXEL_COUNT ? _pixels[indexPixel] : RgbColor(0);
+    }
+
+    void ClearTo(RgbColor color)
+    {
+        for (uint16_t indexPixel = 0; indexPixel < T_PIXEL_COUNT; indexPixel++)
+        {
+            _pixels[indexPixel] = color;
+        }
+        _changed = true;
+    }
+
+    void SetOpacity(uint8_t opacity)
+    {
+        if (opacity != _opacity)
+        {
+            _opacity = opacity;
+            _restyled = true;
+        }
+    }
+
+    uint8_t GetOpacity() const
+    {
+        return _opacity;
+    }
+
+    void SetBlend(LayerBlend blend)
+    {
+        if (blend != _blend)
+        {
+            _blend = blend;
+            _restyled = true;
+        }
+    }
+
+    LayerBlend GetBlend() const
+    {
+        return _blend;
+    }
+
+private:
+    template <typename T_BUS, uint16_t T_COUNT, uint8_t T_LAYER_COUNT>
+    friend class LayerCompositor;
+
+    RgbColor _pixels[T_PIXEL_COUNT];
+    LayerBlend _blend;
+    uint8_t _opacity;
+    // pixels changed since the last composition
+    bool _changed = true;
+    // opacity or blend changed since the last composition
+    bool _restyled = true;
+};
+
+// Composes a stack of layers, the first one at the bottom, into the bus.
+//
+// - the blending is integer only and done in a single pass over the pixels,
+//   every visible layer being folded into the pixel in turn
+// - transparent layers (opacity 0) and the layers under an opaque alpha
+//   layer are left out of the pass
+// - when none of the layers left changed, nothing is done; when a single
+//   one is left, its pixels are copied as they are, so the common case of
+//   one effect costs what drawing on the bus directly did
+// - the bus only marks the pixels whose colour changed, Show() skips the
+//   push when none did
+template <typename T_BUS, uint16_t T_PIXEL_COUNT, uint8_t T_LAYER_COUNT>
+class LayerCompositor
+{
+public:
+    typedef Layer<T_PIXEL_COUNT> LayerType;
+
+    LayerCompositor(T_BUS &bus) : _bus(bus)
+    {
+    }
+
+    LayerType &GetLayer(uint8_t index)
+    {
+        return _layers[index];
+    }
+
+    // the next Compose() redraws the frame, e.g. after something else drew
+    // on the bus
+    void Invalidate()
+    {
+        _invalid = true;
+    }
+
+    // blends `index` into the layer below it, then clears and hides it;
+    // what it showed stays on the pole and the fades of the layer below
+    // start from it
+    void MergeDown(uint8_t index)
+    {
+        if (index == 0 || index >= T_LAYER_COUNT)
+        {
+            return;
+        }
+        LayerType &layer = _layers[index];
+        LayerType &below = _layers[index - 1];
+        if (layer._opacity != 0)
+        {
+            uint16_t weight = Weight(layer._opacity);
+            for (uint16_t pixel = 0; pixel < T_PIXEL_COUNT; pixel++)
+            {
+                below.SetPixelColor(pixel, Blend(below._pixels[pixel], layer._pixels[pixel], layer._blend, weight));
+            }
+        }
+        layer.ClearTo(RgbColor(0));
+        layer.SetOpacity(0);
+    }
+
+    // returns false when no visible layer changed and the bus was left as is
+    bool Compose()
+    {
+        uint8_t visible[T_LAYER_COUNT];
+        uint8_t count = 0;
+        bool changed = _invalid;
+        for (uint8_t index = 0; index < T_LAYER_COUNT; index++)
+        {
+            LayerType &layer = _layers[index];
+            changed = changed || layer._restyled;
+            layer._restyled = false;
+            if (layer._opacity == 0)
+            {
+                continue;
+            }
+            if (layer._blend == LayerBlend_Alpha && layer._opacity == 255)
+            {
+                // hides everything below
+                count = 0;
+            }
+            visible[count++] = index;
+        }
+        for (uint8_t index = 0; index < count; index++)
+        {
+            changed = changed || _layers[visible[index]]._changed;
+        }
+        for (uint8_t index = 0; index < T_LAYER_COUNT; index++)
+        {
+            _layers[index]._changed = false;
+        }
+        _invalid = false;
+        if (!changed)
+        {
+            return false;
+        }
+
+        if (count == 0)
+        {
+            for (uint16_t pixel = 0; pixel < T_PIXEL_COUNT; pixel++)
+            {
+                _bus.SetPixelColor(pixel, RgbColor(0));
+            }
+        }
+        else if (count == 1 && _layers[visible[0]]._opacity == 255 && _layers[visible[0]]._blend != LayerBlend_Multiply)
+        {
+            // alone over black: alpha and add give the layer itself
+            const RgbColor *pixels = _layers[visible[0]]._pixels;
+            for (uint16_t pixel = 0; pixel < T_PIXEL_COUNT; pixel++)
+            {
+                _bus.SetPixelColor(pixel, pixels[pixel]);
+            }
+        }
+        else
+        {
+            uint16_t weights[T_LAYER_COUNT];
+            for (uint8_t index = 0; index < count; index++)
+            {
+                weights[index] = Weight(_layers[visible[index]]._opacity);
+            }
+            for (uint16_t pixel = 0; pixel < T_PIXEL_COUNT; pixel++)
+            {
+                RgbColor color(0);
+                for (uint8_t index = 0; index < count; index++)
+                {
+                    const LayerType &layer = _layers[visible[index]];
+                    color = Blend(color, layer._pixels[pixel], layer._blend, weights[index]);
+                }
+                _bus.SetPixelColor(pixel, color);
+            }
+        }
+        return true;
+    }
+
+private:
+    // opacity 0..255 to a Fixed weight 0..256
+    static uint16_t Weight(uint8_t opacity)
+    {
+        return opacity + (opacity >> 7);
+    }
+
+    static uint8_t Add(uint8_t below, uint8_t above, uint16_t weight)
+    {
+        uint16_t sum = below + (above * weight >> 8);
+        return sum > 255 ? 255 : sum;
+    }
+
+    static uint8_t Multiply(uint8_t below, uint8_t above, uint16_t weight)
+    {
+        uint16_t factor = Fixed::Lerp(255, above, weight);
+        return below * (factor + (factor >> 7)) >> 8;
+    }
+
+    static RgbColor Blend(const RgbColor &below, const RgbColor &above, LayerBlend blend, uint16_t weight)
+    {
+        switch (blend)
+        {
+        case LayerBlend_Add:
+            return RgbColor(Add(below.R, above.R, weight), Add(below.G, above.G, weight), Add(below.B, above.B, weight));
+        case LayerBlend_Multiply:
+            return RgbColor(Multiply(below.R, above.R, weight), Multiply(below.G, above.G, weight),
+                            Multiply(below.B, above.B, weight));
+        default:
+            return Fixed::LinearBlend(below, above, weight);
+        }
+    }
+
+    T_BUS &_bus;
+    LayerType _layers[T_LAYER_COUNT];
+    bool _invalid = true;
+};
+
+// a layer covering the whole pole
+typedef Layer<Pole::PixelCount> PoleLayer;
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <Arduino.h>
+
+// what a mode does when it becomes active, on each frame and when it is left;
+// any of them can be null
+struct ModeHandlers
+{
+    const char *Name;
+    void (*Enter)();
+    void (*Tick)();
+    void (*Exit)();
+};
+
+// Runs the active mode from a table indexed by the T_MODE enum, so the
+// frame loop does an indexed call instead of comparing names. Names are
+// only looked at when a request selects a mode.
+template <typename T_MODE, uint8_t T_COUNT>
+class ModeDispatcher
+{
+public:
+    ModeDispatcher(const ModeHandlers (&modes)[T_COUNT], T_MODE initial)
+        : _modes(modes), _current(initial)
+    {
+    }
+
+    T_MODE Current() const
+    {
+        return _current;
+    }
+
+    const char *Name() const
+    {
+        return _modes[_current].Name;
+    }
+
+    const char *Name(T_MODE mode) const
+    {
+        return mode < T_COUNT ? _modes[mode].Name : "";
+    }
+
+    // leaves the current mode and enters `mode`, even when it is already active
+    void Switch(T_MODE mode)
+    {
+        if (mode >= T_COUNT)
+        {
+            return;
+        }
+        if (_modes[_current].Exit)
+        {
+            _modes[_current].Exit();
+        }
+        _current = mode;
+        if (_modes[_current].Enter)
+        {
+            _modes[_current].Enter();
+        }
+    }
+
+    void Tick()
+    {
+        if (_modes[_current].Tick)
+        {
+            _modes[_current].Tick();
+        }
+    }
+
+    // finds the mode called `name`, only modes from `first` on can be selected
+    bool Parse(const char *name, T_MODE *mode, T_MODE first = (T_MODE)0) const
+    {
+        for (uint8_t index = first; index < T_COUNT; index++)
+        {
+            if (strcmp(name, _modes[index].Name) == 0)
+            {
+                *mode = (T_MODE)index;
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    const ModeHandlers (&_modes)[T_COUNT];
+    T_MODE _current;
+};
@@ -0,0 +1,339 @@
+#pragma once
+
+#include <NeoPixelBus.h>
+#include <tuple>
+#include <utility>
+
+#include "FixedPoint.h"
+
+// The frame of the pole, in linear colour, spread over several strips
+// driven in parallel, one per NeoPixelBus method (e.g. DMA on RX/GPIO3 and
+// asynchronous UART1 on GPIO2).
+//
+// - the pixels are split in consecutive slices, the first outputs taking
+//   one more pixel when the count does not divide evenly; both methods
+//   clock their slice out in the background, so a push lasts as long as
+//   the largest slice instead of the whole frame
+// - gamma and brightness are fused in one 256 entry table, rebuilt when
+//   the brightness changes and applied while copying the frame to the
+//   outputs; the stored colours never lose precision. The table holds 8.8
+//   fixed point levels, rounded to 8 bit when they are written
+// - temporal dithering, SetDithering(): instead of being rounded, the
+//   fraction of each channel is carried to the next push, so a dim level
+//   between two 8 bit steps is shown as a mix of both over a few frames.
+//   At a low brightness few steps are left and fades stair-step without
+//   it; it needs a high frame rate, the eye must not see the frames
+// - Show() is skipped while no pixel value changed since the last push
+// - double buffering: the linear frame is the back buffer the effects draw
+//   in, the pixel buffers of the outputs are the front buffer. Both methods
+//   clock out from their own transfer buffer, so the front buffer can be
+//   rewritten while the previous frame is still on the wire: Present()
+//   fills it and pushes it as soon as every output CanShow(), from Flush(),
+//   instead of blocking in Show() until the wire is free
+template <typename T_COLOR_FEATURE, typename... T_METHODS>
+class MultiPixelBus
+{
+private:
+    typedef typename T_COLOR_FEATURE::ColorObject ColorObject;
+    typedef std::tuple<NeoPixelBus<T_COLOR_FEATURE, T_METHODS>...> Outputs;
+    static constexpr uint8_t Count = sizeof...(T_METHODS);
+
+    template <size_t... I>
+    MultiPixelBus(uint16_t countPixels, std::index_sequence<I...>)
+        : _countPixels(countPixels), _outputs(SlicePixelCount(countPixels, I)...)
+    {
+        _frame = new ColorObject[countPixels];
+        for (uint16_t indexPixel = 0; indexPixel < countPixels; indexPixel++)
+        {
+            _frame[indexPixel] = ColorObject(0);
+        }
+        BuildOutputTable();
+    }
+
+    static constexpr uint16_t SlicePixelCount(uint16_t countPixels, size_t output)
+    {
+        return countPixels / Count + (output < countPixels % Count ? 1 : 0);
+    }
+
+    template <typename T_FUNCTION>
+    void ForEach(T_FUNCTION function)
+    {
+        std::apply([&](auto &...output) { (function(output), ...); }, _outputs);
+    }
+
+    // 8.8 levels, 255.0 for white at full brightness
+    void BuildOutputTable()
+    {
+        for (uint16_t value = 0; value < 256; value++)
+        {
+            uint32_t corrected = Fixed::Ease(Fixed::Gamma, value * 257);
+            _outputTable[value] = corrected * _brightness >> 8;
+        }
+    }
+
+public:
+    MultiPixelBus(uint16_t countPixels) : MultiPixelBus(countPixels, std::index_sequence_for<T_METHODS...>()) {}
+
+    ~MultiPixelBus()
+    {
+        delete[] _frame;
+        delete[] _residues;
+    }
+
+    void Begin()
+    {
+        ForEach([](auto &output) { output.Begin(); });
+        _changed = true;
+    }
+
+    uint16_t PixelCount() const
+    {
+        return _countPixels;
+    }
+
+    uint8_t OutputCount() const
+    {
+        return Count;
+    }
+
+    // pixels clocked out by the largest output, what a push costs on the wire
+    uint16_t LargestOutputPixelCount() const
+    {
+        return SlicePixelCount(_countPixels, 0);
+    }
+
+    // bytes of the linear frame, allocated on the heap by the constructor
+    size_t FrameSize() const
+    {
+        return _countPixels * sizeof(ColorObject);
+    }
+
+    // bytes of the fractions carried by the dithering, allocated the first
+    // time it is enabled
+    size_t DitherSize() const
+    {
+        return _residues ? _countPixels * 3 : 0;
+    }
+
+    // bytes of the wire buffers of all the outputs; the DMA and UART methods
+    // allocate their own transfer buffers on top of them
+    size_t OutputsSize()
+    {
+        size_t size = 0;
+        ForEach([&](auto &output) { size += output.PixelsSize(); });
+        return size;
+    }
+
+    void SetPixelColor(uint16_t indexPixel, ColorObject color)
+    {
+        if (indexPixel < _countPixels && _frame[indexPixel] != color)
+        {
+            _frame[indexPixel] = color;
+            _changed = true;
+        }
+    }
+
+    ColorObject GetPixelColor(uint16_t indexPixel) const
+    {
+        return indexPixel < _countPixels ? _frame[indexPixel] : ColorObject(0);
+    }
+
+    void ClearTo(ColorObject color)
+    {
+        for (uint16_t indexPixel = 0; indexPixel < _countPixels; indexPixel++)
+        {
+            _frame[indexPixel] = color;
+        }
+        _changed = true;
+    }
+
+    void SetBrightness(uint8_t brightness)
+    {
+        if (brightness != _brightness)
+        {
+            _brightness = brightness;
+            BuildOutputTable();
+            _changed = true;
+        }
+    }
+
+    uint8_t GetBrightness() const
+    {
+        return _brightness;
+    }
+
+    void SetDithering(bool dithering)
+    {
+        if (dithering == _dithering)
+        {
+            return;
+        }
+        if (dithering && !_residues)
+        {
+            _residues = new uint8_t[_countPixels * 3];
+        }
+        if (dithering)
+        {
+            memset(_residues, 0, _countPixels * 3);
+        }
+        _dithering = dithering;
+        _changed = true;
+    }
+
+    bool Dithering() const
+    {
+        return _dithering;
+    }
+
+    bool CanShow()
+    {
+        bool ready = true;
+        ForEach([&](auto &output) { ready = ready && output.CanShow(); });
+        return ready;
+    }
+
+    // converts the frame and starts every output, waiting for the previous
+    // frame to be out; returns false when the frame did not change and the
+    // push was skipped. While dithering, a frame is pushed again as long as
+    // a level falls between two steps
+    bool Show()
+    {
+        if (!NeedsPush())
+        {
+            _framesSkipped++;
+            return false;
+        }
+
+        Convert();
+        Push();
+        return true;
+    }
+
+    // converts the frame into the front buffer and pushes it if the wire is
+    // free, never waits; a frame still staged is replaced by the new one
+    bool Present()
+    {
+        if (!NeedsPush())
+        {
+            _framesSkipped++;
+            return false;
+        }
+
+        if (_staged)
+        {
+            _framesReplaced++;
+        }
+        Convert();
+        _staged = true;
+        Flush();
+        return true;
+    }
+
+    // pushes the staged frame once every output can take it, call it from
+    // every loop()
+    bool Flush()
+    {
+        if (!_staged || !CanShow())
+        {
+            return false;
+        }
+        Push();
+        return true;
+    }
+
+    // a presented frame is waiting for the wire
+    bool Staged() const
+    {
+        return _staged;
+    }
+
+    uint32_t FramesPushed() const
+    {
+        return _framesPushed;
+    }
+
+    uint32_t FramesSkipped() const
+    {
+        return _framesSkipped;
+    }
+
+    // staged frames replaced by a newer one before reaching the wire
+    uint32_t FramesReplaced() const
+    {
+        return _framesReplaced;
+    }
+
+private:
+    bool NeedsPush() const
+    {
+        return _changed || (_dithering && _fractional);
+    }
+
+    // the level of a channel, its fraction is carried in `residue`
+    static uint8_t Dither(uint16_t level, uint8_t *residue)
+    {
+        uint16_t sum = level + *residue;
+        *residue = sum & 0xff;
+        return sum >> 8;
+    }
+
+    void Convert()
+    {
+        const ColorObject *source = _frame;
+        uint8_t *residues = _residues;
+        uint16_t fractional = 0;
+        ForEach([&](auto &output) {
+            uint8_t *pixels = output.Pixels();
+            for (uint16_t indexPixel = 0; indexPixel < output.PixelCount(); indexPixel++, source++)
+            {
+                uint16_t red = _outputTable[source->R];
+                uint16_t green = _outputTable[source->G];
+                uint16_t blue = _outputTable[source->B];
+                ColorObject color;
+                if (_dithering)
+                {
+                    fractional |= (red | green | blue) & 0xff;
+                    color = ColorObject(Dither(red, residues), Dither(green, residues + 1), Dither(blue, residues + 2));
+                    residues += 3;
+                }
+                else
+                {
+                    // 255.0 is the largest level, it does not overflow
+                    color = ColorObject((red + 128) >> 8, (green + 128) >> 8, (blue + 128) >> 8);
+                }
+                T_COLOR_FEATURE::applyPixelColor(pixels, indexPixel, color);
+            }
+            output.Dirty();
+        });
+        _fractional = fractional != 0;
+        _changed = false;
+    }
+
+    void Push()
+    {
+        ForEach([](auto &output) { output.Show(); });
+        _staged = false;
+        _framesPushed++;
+    }
+
+    const uint16_t _countPixels;
+    Outputs _outputs;
+    ColorObject *_frame;
+    uint8_t _brightness = 255;
+    uint16_t _outputTable[256];
+    // fraction of each channel left from the last push, while dithering
+    uint8_t *_residues = nullptr;
+    bool _dithering = false;
+    // a level of the last frame converted falls between two steps
+    bool _fractional = false;
+    bool _changed = true;
+    bool _staged = false;
+    uint32_t _framesPushed = 0;
+    uint32_t _framesSkipped = 0;
+    uint32_t _framesReplaced = 0;
+};
+
+// the outputs of the pole: a single strip on RX/GPIO3 through DMA.
+// For a taller pole, add an output to split the frame, e.g.
+// MultiPixelBus<NeoGrbFeature, NeoEsp8266Dma800KbpsMethod, NeoEsp8266AsyncUart800KbpsMethod>
+typedef MultiPixelBus<NeoGrbFeature, NeoEsp8266Dma800KbpsMethod> PoleStrip;
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <ESP8266WiFi.h>
+#include <WiFiUdp.h>
+#include <lwip/dns.h>
+#include <time.h>
+
+// Sets the clock from an NTP pool without ever waiting for the network:
+// Handle() resolves the pool, sends a request, then polls for the reply on
+// the next calls. Between two syncs the time is counted from millis(), so
+// Now() is always available once the first reply came in.
+class NtpSync
+{
+public:
+    static const uint16_t LocalPort = 2390;
+    static const uint16_t ServerPort = 123;
+    static const uint32_t SyncInterval = 60UL * 60 * 1000;
+    // a request without reply is given up after ReplyTimeout and sent again
+    // RetryInterval later
+    static const uint32_t ReplyTimeout = 2000;
+    static const uint32_t RetryInterval = 15000;
+
+    NtpSync(WiFiUDP &udp, const char *server) : _udp(udp), _server(server)
+    {
+    }
+
+    void Begin()
+    {
+        _udp.begin(LocalPort);
+    }
+
+    // `connected`: no request is sent while the WiFi is down
+    void Handle(uint32_t now, bool connected)
+    {
+        switch (_state)
+        {
+        case State_Idle:
+            if (connected && (!_synced || now - _syncMillis >= SyncInterval) && now - _lastAttempt >= RetryInterval)
+            {
+                Resolve(now);
+            }
+            break;
+        case State_Resolving:
+            if (_resolved)
+            {
+                SendRequest(now);
+            }
+            else if (now - _lastAttempt > ReplyTimeout)
+            {
+                _state = State_Idle;
+            }
+            break;
+        case State_Waiting:
+            if (_udp.parsePacket() >= PacketSize)
+            {
+                ReadReply(now);
+            }
+            else if (now - _lastAttempt > ReplyTimeout)
+            {
+                _state = State_Idle;
+            }
+            break;
+        }
+    }
+
+    bool IsSynced() const
+    {
+        return _synced;
+    }
+
+    // UTC seconds since 1970, counted locally since the last sync
+    time_t Now(uint32_t now) const
+    {
+        return _syncEpoch + (now - _syncMillis) / 1000;
+    }
+
+    uint32_t Syncs() const
+    {
+        return _syncs;
+    }
+
+private:
+    enum State
+    {
+        State_Idle,
+        State_Resolving,
+        State_Waiting
+    };
+
+    static const uint8_t PacketSize = 48;
+    // seconds from 1900 (NTP) to 1970 (unix)
+    static const uint32_t SeventyYears = 2208988800UL;
+
+    void Resolve(uint32_t now)
+    {
+        _lastAttempt = now;
+        _resolved = false;
+        _state = State_Resolving;
+        // lwIP answers at once from its cache, else calls back when the
+        // DNS reply comes in; dns_gethostbyname() never blocks
+        ip_addr_t address;
+        if (dns_gethostbyname(_server, &address, DnsFound, this) == ERR_OK)
+        {
+            DnsFound(_server, &address, this);
+        }
+    }
+
+    static void DnsFound(const char *name, const ip_addr_t *address, void *arg)
+    {
+        (void)name;
+        NtpSync *sync = (NtpSync *)arg;
+        if (address && sync->_state == State_Resolving)
+        {
+            // IPv4 lwIP, the address is in network byte order
+            sync->_serverIP = IPAddress(address->addr);
+            sync->_resolved = true;
+        }
+    }
+
+    void SendRequest(uint32_t now)
+    {
+        // drops a late reply to a previous request
+        while (_udp.parsePacket() > 0)
+        {
+            _udp.flush();
+        }
+
+        uint8_t packet[PacketSize] = {};
+        packet[0] = 0b11100011; // LI, Version, Mode
+        packet[1] = 0;          // Stratum, or type of clock
+        packet[2] = 6;          // Polling Interval
+        packet[3] = 0xEC;       // Peer Clock Precision
+        // 8 bytes of zero for Root Delay & Root Dispersion
+        packet[12] = 49;
+        packet[13] = 0x4E;
+        packet[14] = 49;
+        packet[15] = 52;
+        _udp.beginPacket(_serverIP, ServerPort);
+        _udp.write(packet, PacketSize);
+        _udp.endPacket();
+
+        _lastAttempt = now;
+        _state = State_Waiting;
+    }
+
+    void ReadReply(uint32_t now)
+    {
+        uint8_t packet[PacketSize];
+        _udp.read(packet, PacketSize);
+        _state = State_Idle;
+        // a server reply (mode 4) from a synchronised server (stratum 1..15)
+        if ((packet[0] & 0x07) != 4 || packet[1] == 0 || packet[1] > 15)
+        {
+            return;
+        }
+
+        // transmit timestamp: seconds and 1/2^32 fractions since 1900
+        uint32_t seconds = ((uint32_t)packet[40] << 24) | ((uint32_t)packet[41] << 16) |
+                           ((uint32_t)packet[42] << 8) | packet[43];
+        uint32_t fraction = ((uint32_t)packet[44] << 24) | ((uint32_t)packet[45] << 16) |
+                            ((uint32_t)packet[46] << 8) | packet[47];
+        uint32_t milliseconds = ((uint64_t)fraction * 1000) >> 32;
+        // the reply was sent about half a round trip ago
+        uint32_t halfRoundTrip = (now - _lastAttempt) / 2;
+
+        _syncEpoch = seconds - SeventyYears;
+        _syncMillis = now - halfRoundTrip - milliseconds;
+        _synced = true;
+        _syncs++;
+    }
+
+    WiFiUDP &_udp;
+    const char *_server;
+    IPAddress _serverIP;
+    State _state = State_Idle;
+    volatile bool _resolved = false; // set by the lwIP callback
+    bool _synced = false;
+    uint32_t _lastAttempt = (uint32_t)0 - RetryInterval;
+    uint32_t _syncMillis = 0;
+    time_t _syncEpoch = 0;
+    uint32_t _syncs = 0;
+};
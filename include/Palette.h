@@ -0,0 +1,94 @@
+#pragma once
+
+#include <Arduino.h>
+#include <NeoPixelBus.h>
+
+// Colours by an 8 bit index, read from 256 entry tables in flash: the hue
+// wheel and gradient palettes. They replace HslColor, its float division and
+// conversion, in the random colours and the colour of every pixel of the
+// shaders.
+//
+// A gradient is listed as stops (index, colour), from index 0 to 256, and
+// the compiler interpolates the 256 entries between them, like the easing
+// curves of FixedPoint.h.
+namespace Palette
+{
+    struct Stop
+    {
+        uint16_t Index;
+        uint8_t R;
+        uint8_t G;
+        uint8_t B;
+    };
+
+    struct Gradient
+    {
+        uint8_t Values[256][3];
+    };
+
+    template <size_t T_STOP_COUNT>
+    constexpr Gradient Build(const Stop (&stops)[T_STOP_COUNT])
+    {
+        static_assert(T_STOP_COUNT >= 2, "a gradient goes from a stop to another");
+        Gradient gradient = {};
+        size_t next = 1;
+        for (uint16_t index = 0; index < 256; index++)
+        {
+            while (next < T_STOP_COUNT - 1 && stops[next].Index <= index)
+            {
+                next++;
+            }
+            const Stop &from = stops[next - 1];
+            const Stop &to = stops[next];
+            int32_t span = to.Index - from.Index;
+            int32_t offset = index - from.Index;
+            gradient.Values[index][0] = (uint8_t)(from.R + ((int32_t)to.R - from.R) * offset / span);
+            gradient.Values[index][1] = (uint8_t)(from.G + ((int32_t)to.G - from.G) * offset / span);
+            gradient.Values[index][2] = (uint8_t)(from.B + ((int32_t)to.B - from.B) * offset / span);
+        }
+        return gradient;
+    }
+
+    // `color` scaled by `value`, 255 leaves it as is
+    inline RgbColor Scale(RgbColor color, uint8_t value)
+    {
+        uint16_t scale = value + 1;
+        return RgbColor(color.R * scale >> 8, color.G * scale >> 8, color.B * scale >> 8);
+    }
+
+    inline RgbColor Lookup(const Gradient &gradient, uint8_t index)
+    {
+        const uint8_t *entry = gradient.Values[index];
+        return RgbColor(pgm_read_byte(entry), pgm_read_byte(entry + 1), pgm_read_byte(entry + 2));
+    }
+
+    inline RgbColor Lookup(const Gradient &gradient, uint8_t index, uint8_t value)
+    {
+        return Scale(Lookup(gradient, index), value);
+    }
+
+    // the hue wheel at full saturation, what HslColor(hue / 256.0f, 1, 0.5)
+    // gives: red at 0, green at 85, blue at 171
+    inline constexpr Stop RainbowStops[] = {
+        {0, 255, 0, 0}, {43, 255, 255, 0}, {85, 0, 255, 0},   {128, 0, 255, 255},
+        {171, 0, 0, 255}, {213, 255, 0, 255}, {256, 255, 0, 0},
+    };
+    inline constexpr Gradient Rainbow PROGMEM = Build(RainbowStops);
+
+    // black, embers, flames, then the white of the hottest spots
+    inline constexpr Stop LavaStops[] = {
+        {0, 0, 0, 0}, {64, 96, 0, 0}, {128, 255, 32, 0}, {192, 255, 160, 0}, {256, 255, 255, 160},
+    };
+    inline constexpr Gradient Lava PROGMEM = Build(LavaStops);
+
+    // `hue` 0..255 at full saturation, scaled by `value`
+    inline RgbColor Hue(uint8_t hue, uint8_t value = 255)
+    {
+        return Lookup(Rainbow, hue, value);
+    }
+
+    inline RgbColor RandomHue(uint8_t value = 255)
+    {
+        return Hue(random(256), value);
+    }
+}
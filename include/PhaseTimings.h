@@ -0,0 +1,103 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Durations of one phase of loop(), measured with the CPU cycle counter
+// and kept in a fixed log2 histogram: bucket k counts the durations below
+// 2^k µs (bucket 0: under 1µs), the last one everything from 2^15 µs on.
+class TimingHistogram
+{
+public:
+    static const uint8_t BucketCount = 17;
+
+    void Add(uint32_t nanos)
+    {
+        uint32_t micros = nanos / 1000;
+        uint8_t bucket = micros == 0 ? 0 : 32 - __builtin_clz(micros);
+        _buckets[bucket < BucketCount ? bucket : BucketCount - 1]++;
+        _count++;
+        _sumNanos += nanos;
+        _minNanos = min(_minNanos, nanos);
+        _maxNanos = max(_maxNanos, nanos);
+    }
+
+    uint32_t Count() const
+    {
+        return _count;
+    }
+
+    uint64_t SumNanos() const
+    {
+        return _sumNanos;
+    }
+
+    uint32_t MinNanos() const
+    {
+        return _count ? _minNanos : 0;
+    }
+
+    uint32_t MaxNanos() const
+    {
+        return _maxNanos;
+    }
+
+    uint32_t AverageNanos() const
+    {
+        return _count ? _sumNanos / _count : 0;
+    }
+
+    uint32_t Bucket(uint8_t bucket) const
+    {
+        return _buckets[bucket];
+    }
+
+    // upper bound of bucket `bucket`, in µs; the last one has none
+    static uint32_t BucketLimitMicros(uint8_t bucket)
+    {
+        return 1UL << bucket;
+    }
+
+    // upper bound of the bucket holding the `percent` percentile, capped by
+    // the largest duration seen
+    uint32_t PercentileNanos(uint8_t percent) const
+    {
+        uint32_t rank = ((uint64_t)_count * percent + 99) / 100;
+        uint32_t seen = 0;
+        for (uint8_t bucket = 0; bucket < BucketCount - 1; bucket++)
+        {
+            seen += _buckets[bucket];
+            if (seen >= rank)
+            {
+                return min(BucketLimitMicros(bucket) * 1000, _maxNanos);
+            }
+        }
+        return _maxNanos;
+    }
+
+private:
+    uint32_t _buckets[BucketCount] = {};
+    uint32_t _count = 0;
+    uint64_t _sumNanos = 0;
+    uint32_t _minNanos = UINT32_MAX;
+    uint32_t _maxNanos = 0;
+};
+
+// Times the scope it lives in into a histogram:
+//   { ScopedTiming timing(timings[Phase_Show]); strip.Show(); }
+class ScopedTiming
+{
+public:
+    ScopedTiming(TimingHistogram &histogram) : _histogram(histogram), _start(ESP.getCycleCount())
+    {
+    }
+
+    ~ScopedTiming()
+    {
+        uint32_t cycles = ESP.getCycleCount() - _start;
+        _histogram.Add((uint64_t)cycles * 1000 / ESP.getCpuFreqMHz());
+    }
+
+private:
+    TimingHistogram &_histogram;
+    const uint32_t _start;
+};
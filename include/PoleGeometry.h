@@ -0,0 +1,82 @@
+#pragma once
+
+#include <Arduino.h>
+#include <type_traits>
+
+// corner where the first pixel of the strip is soldered,
+// row 0 is the bottom row and column 0 the left column
+enum PoleStartCorner
+{
+    PoleStart_BottomLeft,
+    PoleStart_BottomRight,
+    PoleStart_TopLeft,
+    PoleStart_TopRight
+};
+
+// Describes how the pixels are wired on the pole: T_ROWS rows of T_COLUMNS
+// pixels, each row running the opposite way of the previous one when
+// T_ZIGZAG is set. The (row, column) -> pixel index table is computed by
+// the compiler and kept in flash.
+template <uint8_t T_ROWS, uint8_t T_COLUMNS, bool T_ZIGZAG, PoleStartCorner T_START>
+class PoleGeometry
+{
+public:
+    static constexpr uint8_t RowCount = T_ROWS;
+    static constexpr uint8_t ColumnCount = T_COLUMNS;
+    static constexpr uint16_t PixelCount = (uint16_t)T_ROWS * T_COLUMNS;
+
+    // smallest type that can hold a pixel index
+    typedef typename std::conditional<(PixelCount > 256), uint16_t, uint8_t>::type IndexType;
+
+    // wiring order of the pixel at (rowIndex, colIndex), computed on the fly
+    static constexpr uint16_t WiredIndex(uint8_t rowIndex, uint8_t colIndex)
+    {
+        const bool fromTop = T_START == PoleStart_TopLeft || T_START == PoleStart_TopRight;
+        const bool fromRight = T_START == PoleStart_BottomRight || T_START == PoleStart_TopRight;
+
+        const uint8_t wiredRow = fromTop ? T_ROWS - 1 - rowIndex : rowIndex;
+        const bool reversed = (T_ZIGZAG && (wiredRow % 2 == 1)) != fromRight;
+        const uint8_t offset = reversed ? T_COLUMNS - 1 - colIndex : colIndex;
+        return (uint16_t)wiredRow * T_COLUMNS + offset;
+    }
+
+    // index of the pixel at (rowIndex, colIndex), read from the flash table
+    static uint16_t Index(uint8_t rowIndex, uint8_t colIndex)
+    {
+        if constexpr (sizeof(IndexType) == 1)
+        {
+            return pgm_read_byte(&Table.Values[rowIndex][colIndex]);
+        }
+        else
+        {
+            return pgm_read_word(&Table.Values[rowIndex][colIndex]);
+        }
+    }
+
+private:
+    struct IndexTable
+    {
+        IndexType Values[T_ROWS][T_COLUMNS];
+    };
+
+    static constexpr IndexTable BuildTable()
+    {
+        IndexTable table = {};
+        for (uint8_t row = 0; row < T_ROWS; row++)
+        {
+            for (uint8_t col = 0; col < T_COLUMNS; col++)
+            {
+                table.Values[row][col] = (IndexType)WiredIndex(row, col);
+            }
+        }
+        return table;
+    }
+
+    static constexpr IndexTable Table PROGMEM = BuildTable();
+};
+
+// the pole: 15 rows of 16 leds, soldered in zig-zag from the bottom left
+typedef PoleGeometry<15, 16, true, PoleStart_BottomLeft> Pole;
+
+static_assert(Pole::WiredIndex(0, 15) == 15 && Pole::WiredIndex(1, 0) == 31,
+              "zig-zag rows must alternate their direction");
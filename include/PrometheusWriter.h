@@ -0,0 +1,99 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdarg.h>
+#include <stdio.h>
+
+#include "PhaseTimings.h"
+
+// Writes the Prometheus text format (version 0.0.4) through a small buffer,
+// handed to `sink` each time it fills up and by Flush(), so a long page
+// never needs more RAM than the buffer.
+class PrometheusWriter
+{
+public:
+    typedef void (*Sink)(const char *text, size_t length);
+
+    PrometheusWriter(char *buffer, size_t size, Sink sink) : _buffer(buffer), _size(size), _sink(sink)
+    {
+    }
+
+    void Describe(const char *name, const char *type, const char *help)
+    {
+        Printf("# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+    }
+
+    // `labels` is the inside of the braces, e.g. phase="show", or null
+    void Sample(const char *name, const char *labels, uint32_t value)
+    {
+        Printf("%s%s%s%s %lu\n", name, Open(labels), labels ? labels : "", Close(labels), (unsigned long)value);
+    }
+
+    void SampleSeconds(const char *name, const char *labels, uint64_t nanos)
+    {
+        Printf("%s%s%s%s %lu.%09lu\n", name, Open(labels), labels ? labels : "", Close(labels),
+               (unsigned long)(nanos / 1000000000ULL), (unsigned long)(nanos % 1000000000ULL));
+    }
+
+    // a histogram in seconds: cumulative _bucket lines, _sum and _count
+    void Histogram(const char *name, const char *labels, const TimingHistogram &histogram)
+    {
+        uint32_t cumulative = 0;
+        for (uint8_t bucket = 0; bucket < TimingHistogram::BucketCount - 1; bucket++)
+        {
+            cumulative += histogram.Bucket(bucket);
+            uint32_t limit = TimingHistogram::BucketLimitMicros(bucket);
+            Printf("%s_bucket{%s,le=\"%lu.%06lu\"} %lu\n", name, labels,
+                   (unsigned long)(limit / 1000000), (unsigned long)(limit % 1000000), (unsigned long)cumulative);
+        }
+        Printf("%s_bucket{%s,le=\"+Inf\"} %lu\n", name, labels, (unsigned long)histogram.Count());
+        Printf("%s_sum{%s} %lu.%09lu\n", name, labels,
+               (unsigned long)(histogram.SumNanos() / 1000000000ULL), (unsigned long)(histogram.SumNanos() % 1000000000ULL));
+        Printf("%s_count{%s} %lu\n", name, labels, (unsigned long)histogram.Count());
+    }
+
+    void Flush()
+    {
+        if (_length > 0)
+        {
+            _sink(_buffer, _length);
+            _length = 0;
+        }
+    }
+
+private:
+    static const char *Open(const char *labels)
+    {
+        return labels ? "{" : "";
+    }
+
+    static const char *Close(const char *labels)
+    {
+        return labels ? "}" : "";
+    }
+
+    void Printf(const char *format, ...)
+    {
+        for (uint8_t attempt = 0; attempt < 2; attempt++)
+        {
+            va_list args;
+            va_start(args, format);
+            int written = vsnprintf(_buffer + _length, _size - _length, format, args);
+            va_end(args);
+            if (written >= 0 && _length + written < _size)
+            {
+                _length += written;
+                return;
+            }
+            // no room left: send what is there and write the line again,
+            // a line longer than the whole buffer is dropped
+            _buffer[_length] = 0;
+            Flush();
+        }
+    }
+
+    char *_buffer;
+    size_t _size;
+    Sink _sink;
+    size_t _length = 0;
+};
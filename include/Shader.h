@@ -0,0 +1,245 @@
+#pragma once
+
+#include <Arduino.h>
+#include <NeoPixelBus.h>
+
+#include "Effect.h"
+#include "PoleGeometry.h"
+
+// Integer math for the shaders, tables computed by the compiler and kept in
+// flash like the easing curves of FixedPoint.h.
+//
+// - angles are 8 bit, 256 is a whole turn, so they wrap around the pole on
+//   their own: the columns are AngleStep apart
+// - heights use the same unit, a row is AngleStep above the previous
+//   one, so the shaders are not stretched along the pole
+namespace Shader
+{
+    // distance between two columns (and two rows) in angle units
+    static const uint8_t AngleStep = 256 / Pole::ColumnCount;
+
+    static_assert(256 % Pole::ColumnCount == 0, "the columns must split the turn evenly");
+
+    namespace Tables
+    {
+        // sin(2πx), Taylor series after folding x into [-1/4, 1/4]
+        constexpr double Sin(double turns)
+        {
+            double x = turns - (int)turns;
+            x = x > 0.5 ? x - 1.0 : x < -0.5 ? x + 1.0 : x;
+            x = x > 0.25 ? 0.5 - x : x < -0.25 ? -0.5 - x : x;
+            double radians = x * 6.28318530717958647692;
+            double term = radians;
+            double sum = radians;
+            for (int n = 1; n < 8; n++)
+            {
+                term *= -radians * radians / ((2 * n) * (2 * n + 1));
+                sum += term;
+            }
+            return sum;
+        }
+
+        struct SinTable
+        {
+            int8_t Values[256];
+        };
+
+        constexpr SinTable BuildSin()
+        {
+            SinTable table = {};
+            for (int angle = 0; angle < 256; angle++)
+            {
+                double value = Sin(angle / 256.0) * 127.0;
+                table.Values[angle] = (int8_t)(value < 0.0 ? value - 0.5 : value + 0.5);
+            }
+            return table;
+        }
+
+        // the 256 bytes shuffled by a xorshift, hashes the lattice of Noise()
+        struct Permutation
+        {
+            uint8_t Values[256];
+        };
+
+        constexpr Permutation BuildPermutation()
+        {
+            Permutation table = {};
+            for (int index = 0; index < 256; index++)
+            {
+                table.Values[index] = index;
+            }
+            uint32_t state = 0x2545f491;
+            for (int index = 255; index > 0; index--)
+            {
+                state ^= state << 13;
+                state ^= state >> 17;
+                state ^= state << 5;
+                int other = state % (index + 1);
+                uint8_t swapped = table.Values[index];
+                table.Values[index] = table.Values[other];
+                table.Values[other] = swapped;
+            }
+            return table;
+        }
+
+        // 3f²-2f³ over a cell, the lattice does not show between the values
+        struct FadeTable
+        {
+            uint8_t Values[256];
+        };
+
+        constexpr FadeTable BuildFade()
+        {
+            FadeTable table = {};
+            for (int index = 0; index < 256; index++)
+            {
+                double f = index / 256.0;
+                table.Values[index] = (uint8_t)((3.0 - 2.0 * f) * f * f * 256.0);
+            }
+            return table;
+        }
+
+        inline constexpr SinTable SinValues PROGMEM = BuildSin();
+        inline constexpr Permutation PermutationValues PROGMEM = BuildPermutation();
+        inline constexpr FadeTable FadeValues PROGMEM = BuildFade();
+    }
+
+    // -127..127
+    inline int8_t Sin8(uint8_t angle)
+    {
+        return (int8_t)pgm_read_byte(&Tables::SinValues.Values[angle]);
+    }
+
+    inline int8_t Cos8(uint8_t angle)
+    {
+        return Sin8(angle + 64);
+    }
+
+    // 0..254, 127 for 0
+    inline uint8_t Wave8(uint8_t angle)
+    {
+        return 127 + Sin8(angle);
+    }
+
+    inline uint8_t Lerp8(uint8_t left, uint8_t right, uint8_t weight)
+    {
+        return left + ((int16_t)(right - left) * weight >> 8);
+    }
+
+    inline uint8_t Permute(uint8_t value)
+    {
+        return pgm_read_byte(&Tables::PermutationValues.Values[value]);
+    }
+
+    inline uint8_t Fade(uint8_t fraction)
+    {
+        return pgm_read_byte(&Tables::FadeValues.Values[fraction]);
+    }
+
+    // Value noise 0..255 over a lattice that turns around the pole: the
+    // angle crosses NoiseCells cells per turn and wraps with it, `y` and `z`
+    // are 8.8 lattice coordinates (cell, fraction), e.g. height and time.
+    //
+    // The noise is interpolated along `y` and `z` first, for the NoiseCells
+    // lattice columns at once, then At() only interpolates between the two
+    // columns around the angle: a row of the pole costs NoiseCells lattice
+    // lookups plus a lerp per pixel.
+    static const uint8_t NoiseCells = 4;
+
+    class NoiseRow
+    {
+    public:
+        void Set(uint16_t y, uint16_t z)
+        {
+            uint8_t y0 = y >> 8;
+            uint8_t z0 = z >> 8;
+            uint8_t fy = Fade(y & 0xff);
+            uint8_t fz = Fade(z & 0xff);
+            // the lattice is hashed z, then y, then x, so the first two
+            // steps are shared by the whole row
+            uint8_t near0 = Permute(Permute(z0) + y0);
+            uint8_t near1 = Permute(Permute(z0) + y0 + 1);
+            uint8_t far0 = Permute(Permute(z0 + 1) + y0);
+            uint8_t far1 = Permute(Permute(z0 + 1) + y0 + 1);
+            for (uint8_t x = 0; x < NoiseCells; x++)
+            {
+                _values[x] = Lerp8(Lerp8(Permute(near0 + x), Permute(near1 + x), fy),
+                                   Lerp8(Permute(far0 + x), Permute(far1 + x), fy), fz);
+            }
+        }
+
+        uint8_t At(uint8_t angle) const
+        {
+            static const uint8_t CellAngle = 256 / NoiseCells;
+            uint8_t x0 = angle / CellAngle;
+            uint8_t fx = Fade(angle % CellAngle * (256 / CellAngle));
+            return Lerp8(_values[x0], _values[(x0 + 1) % NoiseCells], fx);
+        }
+
+    private:
+        uint8_t _values[NoiseCells] = {};
+    };
+
+    inline uint8_t Noise(uint8_t angle, uint16_t y, uint16_t z)
+    {
+        NoiseRow row;
+        row.Set(y, z);
+        return row.At(angle);
+    }
+}
+
+// Runs T_SHADER over the whole pole on every frame. A shader is a function
+// of the position and the time, with no state kept between frames:
+//
+//   struct Plasma
+//   {
+//       void Frame(uint32_t time);                    // ms, once per frame
+//       void Row(uint8_t row);                        // once per row
+//       RgbColor Shade(uint8_t row, uint8_t angle);   // once per pixel
+//   };
+//
+// Frame() and Row() compute whatever depends on the time and the row only,
+// so Shade() is left with the work per pixel. The angle of a column is
+// column * AngleStep.
+template <typename T_SHADER>
+class ShaderEffect : public Effect
+{
+public:
+    static const uint16_t ChannelCount = 1;
+    // the channel only paces the frames, it restarts when it completes
+    static const uint16_t FrameChannelDuration = 60000;
+
+    ShaderEffect(const EffectContext &context) : Effect(context, ChannelCount)
+    {
+    }
+
+    void Start() override
+    {
+        Render(millis());
+        StartChannel(0, FrameChannelDuration, [this](const AnimationParam &param) {
+            if (param.state == AnimationState_Completed)
+            {
+                _context.Animations.RestartAnimation(param.index);
+            }
+            Render(millis());
+        });
+    }
+
+    void Render(uint32_t time)
+    {
+        _shader.Frame(time);
+        for (uint8_t row = 0; row < Pole::RowCount; row++)
+        {
+            _shader.Row(row);
+            uint8_t angle = 0;
+            for (uint8_t column = 0; column < Pole::ColumnCount; column++)
+            {
+                _context.Canvas.SetPixelColor(Pole::Index(row, column), _shader.Shade(row, angle));
+                angle += Shader::AngleStep;
+            }
+        }
+    }
+
+private:
+    T_SHADER _shader;
+};
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <Arduino.h>
+#include <FS.h>
+#include <type_traits>
+
+// Keeps the last T_STATE across resets and power losses, so setup() can
+// restore it before anything else:
+//
+// - RTC user memory is written on every change; it survives a reset, a
+//   watchdog or a crash, but not a power loss, and reading it costs nothing
+// - the flash copy is a LittleFS file, written only once a state lasted
+//   FlashDelay, so a brightness slider does not wear the flash; LittleFS
+//   spreads the writes over its blocks, and the file is replaced by a
+//   rename so a power loss never leaves half a record
+//
+// Both copies carry a magic and a checksum, the RTC memory holds garbage
+// after a power up. T_STATE is compared and copied as bytes: it must be
+// trivial and value-initialized (`= {}`), with no padding.
+//
+// The owner calls MarkChanged() wherever the state may change, and Handle()
+// only builds the state after that: loop() does not rebuild it every pass.
+template <typename T_STATE>
+class StateStore
+{
+    static_assert(std::is_trivially_copyable<T_STATE>::value, "the state is copied as bytes");
+    static_assert(std::has_unique_object_representations<T_STATE>::value,
+                  "the state is compared as bytes, it must have no padding");
+
+public:
+    // ms a state must last before it is written to the flash, and between
+    // two tries when the write fails (e.g. the flash is full)
+    static const uint32_t FlashDelay = 10000;
+    // first RTC user memory block used, the first 32 are lost on OTA updates
+    static const uint32_t RtcOffset = 32;
+
+    enum Source
+    {
+        Source_None,
+        Source_Rtc,
+        Source_Flash
+    };
+
+    StateStore(FS &fs, const char *path, const char *temporaryPath)
+        : _fs(fs), _path(path), _temporaryPath(temporaryPath)
+    {
+    }
+
+    // the state saved last, from the RTC memory after a reset, else from the
+    // flash; Source_None on the first boot
+    Source Restore(T_STATE *state)
+    {
+        Source source = Source_None;
+        if (ESP.rtcUserMemoryRead(RtcOffset, (uint32_t *)&_record, sizeof(_record)) && IsValid(_record))
+        {
+            source = Source_Rtc;
+        }
+        else
+        {
+            File file = _fs.open(_path, "r");
+            if (file && file.read((uint8_t *)&_record, sizeof(_record)) == sizeof(_record) && IsValid(_record))
+            {
+                source = Source_Flash;
+            }
+        }
+        if (source == Source_None)
+        {
+            _record = {};
+            return source;
+        }
+        *state = _record.State;
+        return source;
+    }
+
+    // the state may have changed, the next Handle() reads it
+    void MarkChanged()
+    {
+        _changed = true;
+    }
+
+    // once marked changed, records the state returned by `current()` if it
+    // differs from the last one; otherwise only checks the flash deadline,
+    // `now` in ms
+    template <typename T_CURRENT>
+    void Handle(uint32_t now, T_CURRENT current)
+    {
+        if (_changed)
+        {
+            _changed = false;
+            const T_STATE state = current();
+            if (memcmp(&state, &_record.State, sizeof(T_STATE)) != 0)
+            {
+                _record.Magic = Magic;
+                _record.State = state;
+                _record.Checksum = Checksum(_record);
+                ESP.rtcUserMemoryWrite(RtcOffset, (uint32_t *)&_record, sizeof(_record));
+                _changedAt = now;
+                _flashPending = true;
+            }
+        }
+        if (_flashPending && now - _changedAt >= FlashDelay)
+        {
+            if (WriteFlash())
+            {
+                _flashPending = false;
+            }
+            else
+            {
+                _changedAt = now;
+            }
+        }
+    }
+
+    uint32_t FlashWrites() const
+    {
+        return _flashWrites;
+    }
+
+    uint32_t FlashFailures() const
+    {
+        return _flashFailures;
+    }
+
+private:
+    // "LPS1", to change with the layout of the record or of T_STATE
+    static const uint32_t Magic = 0x3153504c;
+
+    struct Record
+    {
+        uint32_t Magic;
+        T_STATE State;
+        uint32_t Checksum;
+    };
+    static_assert(sizeof(Record) % 4 == 0, "the RTC memory is read and written by 4 byte blocks");
+
+    // FNV-1a of the magic and the state
+    static uint32_t Checksum(const Record &record)
+    {
+        const uint8_t *bytes = (const uint8_t *)&record;
+        uint32_t hash = 2166136261u;
+        for (size_t index = 0; index < offsetof(Record, Checksum); index++)
+        {
+            hash = (hash ^ bytes[index]) * 16777619u;
+        }
+        return hash;
+    }
+
+    static bool IsValid(const Record &record)
+    {
+        return record.Magic == Magic && record.Checksum == Checksum(record);
+    }
+
+    bool WriteFlash()
+    {
+        File file = _fs.open(_temporaryPath, "w");
+        bool written = file && file.write((const uint8_t *)&_record, sizeof(_record)) == sizeof(_record);
+        file.close();
+        if (!written || !_fs.rename(_temporaryPath, _path))
+        {
+            _flashFailures++;
+            return false;
+        }
+        _flashWrites++;
+        return true;
+    }
+
+    FS &_fs;
+    const char *const _path;
+    const char *const _temporaryPath;
+    Record _record = {};
+    uint32_t _changedAt = 0;
+    bool _changed = false;
+    bool _flashPending = false;
+    uint32_t _flashWrites = 0;
+    uint32_t _flashFailures = 0;
+};
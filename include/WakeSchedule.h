@@ -0,0 +1,110 @@
+#pragma once
+
+#include <TimeLib.h>
+#include <Timezone.h>
+
+// one wake-up: on the `Weekdays` (bit 0 is sunday, as TimeLib's weekday() - 1)
+// at Hour:Minute local time, switch to `Mode`; with a `Ramp`, the mode starts
+// that many seconds earlier with the brightness rising from 0, so the pole
+// is fully lit at the alarm time
+struct Alarm
+{
+    bool Enabled;
+    uint8_t Weekdays;
+    uint8_t Hour;
+    uint8_t Minute;
+    uint8_t Mode;
+    uint16_t Ramp;
+};
+
+// The table of wake-ups. The next one to fire is computed by Plan() after
+// each change of the table or of the clock, so checking it in loop() is a
+// single compare with the current time.
+template <uint8_t T_COUNT>
+class WakeSchedule
+{
+public:
+    static const uint8_t Count = T_COUNT;
+    static const uint8_t EveryDay = 0x7f;
+    static constexpr time_t Never = (time_t)0x7fffffff;
+
+    WakeSchedule(Timezone &zone) : _zone(zone)
+    {
+        for (uint8_t index = 0; index < T_COUNT; index++)
+        {
+            _alarms[index] = {false, EveryDay, 0, 0, 0, 0};
+        }
+    }
+
+    const Alarm &Get(uint8_t index) const
+    {
+        return _alarms[index];
+    }
+
+    // call Plan() afterwards
+    void Set(uint8_t index, const Alarm &alarm)
+    {
+        if (index < T_COUNT)
+        {
+            _alarms[index] = alarm;
+        }
+    }
+
+    // finds the first alarm firing after `utc`
+    void Plan(time_t utc)
+    {
+        _next = Never;
+        _nextIndex = 0;
+        time_t local = _zone.toLocal(utc);
+        time_t midnight = local - local % SECS_PER_DAY;
+        for (uint8_t index = 0; index < T_COUNT; index++)
+        {
+            const Alarm &alarm = _alarms[index];
+            if (!alarm.Enabled)
+            {
+                continue;
+            }
+            // today and the next 7 days, the ramp may start the day before
+            for (uint8_t dayOffset = 0; dayOffset <= 7; dayOffset++)
+            {
+                time_t alarmLocal = midnight + dayOffset * SECS_PER_DAY + alarm.Hour * SECS_PER_HOUR + alarm.Minute * SECS_PER_MIN;
+                if (!(alarm.Weekdays & (1 << (weekday(alarmLocal) - 1))))
+                {
+                    continue;
+                }
+                time_t fire = _zone.toUTC(alarmLocal) - alarm.Ramp;
+                if (fire > utc)
+                {
+                    if (fire < _next)
+                    {
+                        _next = fire;
+                        _nextIndex = index;
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    bool Due(time_t utc) const
+    {
+        return utc >= _next;
+    }
+
+    // UTC time of the next alarm, Never if none is enabled
+    time_t Next() const
+    {
+        return _next;
+    }
+
+    uint8_t NextIndex() const
+    {
+        return _nextIndex;
+    }
+
+private:
+    Timezone &_zone;
+    Alarm _alarms[T_COUNT];
+    time_t _next = Never;
+    uint8_t _nextIndex = 0;
+};
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <ESP8266WiFi.h>
+
+// Connects the station without ever waiting: Handle() is called on each
+// loop(), looks at WiFi.status() and moves between
+//
+//   Connecting --connected--> Connected --lost--> Connecting
+//       |                                             ^
+//       +--failed or ConnectTimeout--> Backoff --delay+
+//
+// The delay before a new attempt doubles after each failure, from
+// MinBackoff to MaxBackoff, and starts over once connected.
+class WiFiConnection
+{
+public:
+    enum State
+    {
+        State_Idle,
+        State_Connecting,
+        State_Connected,
+        State_Backoff
+    };
+
+    // what changed during a Handle()
+    enum Event
+    {
+        Event_None,
+        Event_Connected,
+        Event_Lost,
+        Event_Failed
+    };
+
+    static const uint32_t ConnectTimeout = 10000;
+    static const uint32_t MinBackoff = 1000;
+    static const uint32_t MaxBackoff = 60000;
+
+    WiFiConnection(const char *ssid, const char *password) : _ssid(ssid), _password(password)
+    {
+    }
+
+    void Begin(uint32_t now)
+    {
+        // the core would retry on its own, with its own timing
+        WiFi.persistent(false);
+        WiFi.setAutoReconnect(false);
+        _backoff = MinBackoff;
+        Connect(now);
+    }
+
+    Event Handle(uint32_t now)
+    {
+        bool connected = WiFi.status() == WL_CONNECTED;
+        switch (_state)
+        {
+        case State_Connecting:
+            if (connected)
+            {
+                _state = State_Connected;
+                _backoff = MinBackoff;
+                return Event_Connected;
+            }
+            if (now - _since > ConnectTimeout || WiFi.status() == WL_CONNECT_FAILED || WiFi.status() == WL_NO_SSID_AVAIL)
+            {
+                WiFi.disconnect();
+                _state = State_Backoff;
+                _since = now;
+                _failures++;
+                return Event_Failed;
+            }
+            break;
+        case State_Connected:
+            if (!connected)
+            {
+                Connect(now);
+                return Event_Lost;
+            }
+            break;
+        case State_Backoff:
+            if (now - _since > _backoff)
+            {
+                _backoff = _backoff * 2 < MaxBackoff ? _backoff * 2 : MaxBackoff;
+                Connect(now);
+            }
+            break;
+        case State_Idle:
+            break;
+        }
+        return Event_None;
+    }
+
+    State GetState() const
+    {
+        return _state;
+    }
+
+    bool IsConnected() const
+    {
+        return _state == State_Connected;
+    }
+
+    // failed attempts since boot
+    uint32_t Failures() const
+    {
+        return _failures;
+    }
+
+private:
+    void Connect(uint32_t now)
+    {
+        WiFi.begin(_ssid, _password);
+        _state = State_Connecting;
+        _since = now;
+    }
+
+    const char *_ssid;
+    const char *_password;
+    State _state = State_Idle;
+    uint32_t _since = 0;
+    uint32_t _backoff = MinBackoff;
+    uint32_t _failures = 0;
+};
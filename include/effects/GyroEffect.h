@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Effect.h"
+#include "FixedPoint.h"
+
+// a lit column turns around the pole, leaving a tail of columns fading out;
+// the color changes on each turn
+template <uint16_t T_FADE_DURATION, uint8_t T_LIGHTNESS_PERCENT>
+class GyroEffect : public Effect
+{
+public:
+    // move speed, one turn in 700ms
+    static const uint16_t MoveDuration = 700 / Pole::ColumnCount;
+    // channel 0 is the timer, then one channel per column still fading out
+    static const uint16_t ChannelCount = T_FADE_DURATION / MoveDuration + 2;
+    // value of the hue with the HSL lightness asked, 50% is the full colour
+    static const uint8_t FrontValue = T_LIGHTNESS_PERCENT * 255 / 50;
+
+    static_assert(T_LIGHTNESS_PERCENT <= 50, "past 50% the colour goes to white");
+
+    GyroEffect(const EffectContext &context) : Effect(context, ChannelCount)
+    {
+    }
+
+    void Start() override
+    {
+        _frontColumn = 0;
+        StartTimer(MoveDuration);
+    }
+
+protected:
+    void Step() override
+    {
+        // pick the next column inline to start animating
+        _frontColumn = (_frontColumn + 1) % Pole::ColumnCount; // increment and wrap
+        if (_frontColumn == 0)
+        {
+            // we looped, lets pick a new front color
+            _frontColor = RandomColor(FrontValue);
+        }
+
+        uint16_t channel;
+        // if you see skipping, then either you are going to fast or need to increase
+        // the number of animation channels
+        if (NextAvailableChannel(&channel))
+        {
+            _columns[channel].StartingColor = _frontColor;
+            _columns[channel].EndingColor = RgbColor(0, 0, 0);
+            _columns[channel].Column = _frontColumn;
+
+            StartChannel(channel, T_FADE_DURATION, [this](const AnimationParam &param) {
+                ColumnFadeOut(param);
+            });
+        }
+    }
+
+private:
+    struct ColumnState
+    {
+        RgbColor StartingColor;
+        RgbColor EndingColor;
+        uint8_t Column; // which column this animation is effecting
+    };
+
+    void ColumnFadeOut(const AnimationParam &param)
+    {
+        const ColumnState &state = _columns[ChannelOf(param)];
+        // gamma is corrected by the strip when the frame is pushed
+        FillColumn(state.Column, Fixed::LinearBlend(state.StartingColor, state.EndingColor,
+                                                    Fixed::Weight(Fixed::FromUnit(param.progress))));
+    }
+
+    ColumnState _columns[ChannelCount];
+    uint8_t _frontColumn = 0;        // the front of the loop
+    RgbColor _frontColor = RgbColor(0); // the color at the front of the loop
+};
+
+// GYRO, the original firmware mode
+typedef GyroEffect<500, 50> Gyro;
+// GYRO1, experiments/gyro1.cpp: a shorter and dimmer tail
+typedef GyroEffect<200, 15> Gyro1;
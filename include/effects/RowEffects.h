@@ -0,0 +1,123 @@
+#pragma once
+
+#include "Effect.h"
+#include "FixedPoint.h"
+
+// Effects of experiments/rows-*.cpp: the timer walks up the rows and each
+// step fades one or two whole rows to a new color on the other channels.
+template <uint16_t T_CHANNEL_COUNT>
+class RowFadeEffect : public Effect
+{
+public:
+    static const uint16_t ChannelCount = T_CHANNEL_COUNT;
+    static const uint16_t MoveDuration = 100; // how fast we move through the rows
+    static const uint16_t FadeDuration = 50;
+
+    RowFadeEffect(const EffectContext &context) : Effect(context, ChannelCount)
+    {
+    }
+
+    void Start() override
+    {
+        _row = 0;
+        StartTimer(MoveDuration);
+    }
+
+protected:
+    // fades `row` from its current color to `color`
+    void FadeRow(uint8_t row, RgbColor color)
+    {
+        uint16_t channel;
+        if (NextAvailableChannel(&channel))
+        {
+            _rows[channel].StartingColor = _context.Canvas.GetPixelColor(Pole::Index(row, 0));
+            _rows[channel].EndingColor = color;
+            _rows[channel].Row = row;
+
+            StartChannel(channel, FadeDuration, [this](const AnimationParam &param) {
+                RowFadeUpdate(param);
+            });
+        }
+    }
+
+    uint8_t PreviousRow() const
+    {
+        return (_row + Pole::RowCount - 1) % Pole::RowCount;
+    }
+
+    uint8_t _row = 0; // the front of the loop
+    RgbColor _color = RgbColor(0);
+
+private:
+    struct RowState
+    {
+        RgbColor StartingColor;
+        RgbColor EndingColor;
+        uint8_t Row;
+    };
+
+    void RowFadeUpdate(const AnimationParam &param)
+    {
+        const RowState &state = _rows[ChannelOf(param)];
+        FillRow(state.Row, Fixed::LinearBlend(state.StartingColor, state.EndingColor,
+                                              Fixed::Weight(Fixed::FromUnit(param.progress))));
+    }
+
+    RowState _rows[ChannelCount];
+};
+
+// RAINBOW, rows-rainbowloop.cpp: each row takes a new random color
+class RainbowEffect : public RowFadeEffect<2>
+{
+public:
+    using RowFadeEffect::RowFadeEffect;
+
+protected:
+    void Step() override
+    {
+        _row = (_row + 1) % Pole::RowCount;
+        FadeRow(PreviousRow(), RandomColor());
+    }
+};
+
+// RAINBOW2, rows-rainbowloop2.cpp: the color changes once per climb,
+// painting the pole with bands
+class Rainbow2Effect : public RowFadeEffect<2>
+{
+public:
+    using RowFadeEffect::RowFadeEffect;
+
+protected:
+    void Step() override
+    {
+        if (_row == 0)
+        {
+            _color = RandomColor();
+        }
+        _row = (_row + 1) % Pole::RowCount;
+        FadeRow(PreviousRow(), _color);
+    }
+};
+
+// STRIPES, rows-running-stripes.cpp: a single lit row climbs the pole,
+// the one it leaves fades to black
+class StripesEffect : public RowFadeEffect<4>
+{
+public:
+    using RowFadeEffect::RowFadeEffect;
+
+protected:
+    void Step() override
+    {
+        // hide previous
+        FadeRow(PreviousRow(), RgbColor(0, 0, 0));
+        // resetColor on each start
+        if (_row == 0)
+        {
+            _color = RandomColor();
+        }
+        // show current
+        FadeRow(_row, _color);
+        _row = (_row + 1) % Pole::RowCount;
+    }
+};
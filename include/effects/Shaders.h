@@ -0,0 +1,103 @@
+#pragma once
+
+#include "Palette.h"
+#include "Shader.h"
+
+// Shaders for ShaderEffect: a colour per (row, angle), the angle wrapping
+// around the pole. Phases are 8 bit angles, computed once per frame from
+// the time in ms.
+
+// PLASMA: three sine waves crossing, one around the pole, one along it and
+// one diagonal, their sum picks the hue
+struct PlasmaShader
+{
+    void Frame(uint32_t time)
+    {
+        _around = time / 11;
+        _along = time / 17;
+        _diagonal = time / 23;
+        _hue = time / 64;
+    }
+
+    void Row(uint8_t row)
+    {
+        uint8_t height = row * Shader::AngleStep;
+        _alongWave = Shader::Sin8(height + _along);
+        _diagonalPhase = height / 2 - _diagonal;
+    }
+
+    RgbColor Shade(uint8_t, uint8_t angle) const
+    {
+        int16_t sum = Shader::Sin8(angle * 2 + _around) + _alongWave + Shader::Sin8(angle + _diagonalPhase);
+        return Palette::Hue(_hue + (sum >> 2));
+    }
+
+    uint8_t _around = 0;
+    uint8_t _along = 0;
+    uint8_t _diagonal = 0;
+    uint8_t _hue = 0;
+    int8_t _alongWave = 0;
+    uint8_t _diagonalPhase = 0;
+};
+
+// SPIRAL: the rainbow wound around the pole and turning, darker bands
+// winding the other way
+struct RainbowSpiralShader
+{
+    // hue shift from one row to the next, the pitch of the spiral
+    static const uint8_t Twist = 12;
+
+    void Frame(uint32_t time)
+    {
+        _turn = time / 8;
+        _bands = time / 5;
+    }
+
+    void Row(uint8_t)
+    {
+    }
+
+    RgbColor Shade(uint8_t row, uint8_t angle) const
+    {
+        uint8_t hue = angle + row * Twist - _turn;
+        uint8_t band = Shader::Wave8(angle * 2 - row * Twist * 2 + _bands);
+        return Palette::Hue(hue, 96 + (band * 5 >> 3));
+    }
+
+    uint8_t _turn = 0;
+    uint8_t _bands = 0;
+};
+
+// NOISE: value noise rising along the pole and slowly turning, coloured by
+// the Lava palette like flames
+struct NoiseFlowShader
+{
+    // lattice units per row, about 5 rows per noise cell
+    static const uint8_t RowScale = 48;
+
+    void Frame(uint32_t time)
+    {
+        _drift = time / 64;
+        _rise = time / 4;
+        _depth = time / 8;
+    }
+
+    void Row(uint8_t row)
+    {
+        _noise.Set(row * RowScale - _rise, _depth);
+    }
+
+    RgbColor Shade(uint8_t, uint8_t angle) const
+    {
+        return Palette::Lookup(Palette::Lava, _noise.At(angle + _drift));
+    }
+
+    uint8_t _drift = 0;
+    uint16_t _rise = 0;
+    uint16_t _depth = 0;
+    Shader::NoiseRow _noise;
+};
+
+typedef ShaderEffect<PlasmaShader> PlasmaEffect;
+typedef ShaderEffect<RainbowSpiralShader> RainbowSpiralEffect;
+typedef ShaderEffect<NoiseFlowShader> NoiseFlowEffect;
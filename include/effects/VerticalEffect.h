@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Effect.h"
+
+// a lit row climbs the pole with a tail of darker rows below it;
+// the color changes each time it starts again from the bottom
+class VerticalEffect : public Effect
+{
+public:
+    static const uint16_t MoveDuration = 100;
+    static const uint16_t ChannelCount = 1;
+    static const uint8_t TailLength = 5;
+
+    VerticalEffect(const EffectContext &context) : Effect(context, ChannelCount)
+    {
+    }
+
+    void Start() override
+    {
+        _row = 0;
+        StartTimer(MoveDuration);
+    }
+
+protected:
+    void Step() override
+    {
+        if (_row == 0)
+        {
+            // we looped, lets pick a new front color
+            _rowColor = RandomColor();
+        }
+
+        FillRow(_row, _rowColor);
+        // traînée de lignes de plus en plus sombres sous la ligne courante
+        RgbColor tailColor = _rowColor;
+        for (uint8_t offset = 1; offset <= TailLength && offset <= _row; offset += 1)
+        {
+            tailColor.Darken(10 * offset);
+            FillRow(_row - offset, tailColor);
+        }
+        _row = (_row + 1) % Pole::RowCount; // increment and wrap
+    }
+
+private:
+    uint8_t _row = 0;
+    RgbColor _rowColor = RgbColor(0);
+};
@@ -0,0 +1,48 @@
+// Host stand-in for the ESP8266 Arduino core, used by the `native` and `bench`
+// environments so the firmware sources compile and run on Linux.
+// Only the subset used by the firmware is provided.
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <math.h>
+#include <algorithm>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define PGM_P const char *
+#define strlen_P strlen
+#define memcpy_P memcpy
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+
+#define DEC 10
+#define HEX 16
+
+using std::max;
+using std::min;
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+int analogRead(uint8_t pin);
+
+#include "WString.h"
+#include "Print.h"
+#include "HardwareSerial.h"
+#include "Esp.h"
+#include "NativeHost.h"
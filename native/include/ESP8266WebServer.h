@@ -0,0 +1,162 @@
+// Host stand-in for ESP8266WebServer: there is no socket, requests are
+// injected in-process with Request() or Upload() and the handler's reply
+// is captured.
+#pragma once
+
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include <functional>
+#include <vector>
+
+#define CONTENT_LENGTH_UNKNOWN ((size_t)-1)
+
+enum HTTPMethod
+{
+    HTTP_ANY,
+    HTTP_GET,
+    HTTP_POST
+};
+
+#define HTTP_UPLOAD_BUFLEN 2048
+
+enum HTTPUploadStatus
+{
+    UPLOAD_FILE_START,
+    UPLOAD_FILE_WRITE,
+    UPLOAD_FILE_END,
+    UPLOAD_FILE_ABORTED
+};
+
+struct HTTPUpload
+{
+    HTTPUploadStatus status;
+    String filename;
+    String name;
+    String type;
+    size_t totalSize;
+    size_t currentSize;
+    uint8_t buf[HTTP_UPLOAD_BUFLEN];
+};
+
+class ESP8266WebServer
+{
+public:
+    typedef std::function<void(void)> THandlerFunction;
+
+    ESP8266WebServer(int port = 80) : _port(port) {}
+
+    void begin() {}
+    void handleClient() {}
+
+    void on(const String &uri, THandlerFunction handler)
+    {
+        on(uri, HTTP_ANY, handler);
+    }
+    void on(const String &uri, HTTPMethod method, THandlerFunction handler)
+    {
+        _handlers.push_back({uri, method, handler, nullptr});
+    }
+    // `upload` is called for each piece of a multipart file, then `handler`
+    void on(const String &uri, HTTPMethod method, THandlerFunction handler, THandlerFunction upload)
+    {
+        _handlers.push_back({uri, method, handler, upload});
+    }
+    void onNotFound(THandlerFunction handler)
+    {
+        _notFoundHandler = handler;
+    }
+
+    const String &uri() const
+    {
+        return _currentUri;
+    }
+    HTTPMethod method() const
+    {
+        return _currentMethod;
+    }
+    HTTPUpload &upload()
+    {
+        return _upload;
+    }
+    int args() const
+    {
+        return (int)_args.size();
+    }
+    // like the 3.x core, arguments are returned by reference, no copy
+    const String &argName(int index) const;
+    const String &arg(int index) const;
+    const String &arg(const String &name) const;
+    bool hasArg(const String &name) const;
+
+    void send(int code, const char *contentType = nullptr, const String &content = String(""));
+    void send(int code, const String &contentType, const String &content)
+    {
+        send(code, contentType.c_str(), content);
+    }
+    void send(int code, const char *contentType, const char *content, size_t contentLength);
+    void send_P(int code, PGM_P contentType, PGM_P content)
+    {
+        send(code, contentType, content, strlen_P(content));
+    }
+
+    // chunked replies: setContentLength(CONTENT_LENGTH_UNKNOWN), send() the
+    // headers with an empty body, then sendContent() each piece
+    void setContentLength(size_t contentLength)
+    {
+        (void)contentLength;
+    }
+    void sendContent(const char *content, size_t contentLength)
+    {
+        _responseBody += String(std::string(content, contentLength));
+    }
+    void sendContent(const String &content)
+    {
+        _responseBody += content;
+    }
+
+    // host only: dispatches "/path?name=value&..." to the registered handler
+    // and returns the status code it replied with
+    int Request(const char *target, HTTPMethod method = HTTP_GET);
+    // host only: POSTs `data` as the multipart file `filename`, handed to the
+    // upload handler in HTTP_UPLOAD_BUFLEN pieces; `abort` drops the
+    // connection halfway like a client going away
+    int Upload(const char *target, const uint8_t *data, size_t size, const char *filename, bool abort = false);
+    const String &ResponseBody() const
+    {
+        return _responseBody;
+    }
+    const String &ResponseType() const
+    {
+        return _responseType;
+    }
+
+private:
+    struct Handler
+    {
+        String Uri;
+        HTTPMethod Method;
+        THandlerFunction Function;
+        THandlerFunction UploadFunction;
+    };
+    struct Arg
+    {
+        String Name;
+        String Value;
+    };
+
+    void Parse(const char *target, HTTPMethod method);
+    const Handler *Find() const;
+
+    int _port;
+    std::vector<Handler> _handlers;
+    THandlerFunction _notFoundHandler;
+
+    String _currentUri;
+    HTTPMethod _currentMethod = HTTP_GET;
+    std::vector<Arg> _args;
+    HTTPUpload _upload;
+
+    int _responseCode = 0;
+    String _responseType;
+    String _responseBody;
+};
@@ -0,0 +1,74 @@
+// Host stand-in for the ESP8266 WiFi station: the host is always "connected"
+// unless a test forces another status through SetStatus().
+#pragma once
+
+#include <Arduino.h>
+#include "IPAddress.h"
+
+typedef enum
+{
+    WL_NO_SHIELD = 255,
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_SCAN_COMPLETED = 2,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_DISCONNECTED = 6
+} wl_status_t;
+
+class ESP8266WiFiClass
+{
+public:
+    wl_status_t begin(const char *ssid, const char *passphrase = nullptr)
+    {
+        (void)ssid;
+        (void)passphrase;
+        if (_status != WL_CONNECTED && !_forced)
+        {
+            _status = WL_CONNECTED;
+        }
+        return _status;
+    }
+
+    bool disconnect(bool wifioff = false)
+    {
+        (void)wifioff;
+        _status = WL_DISCONNECTED;
+        return true;
+    }
+
+    wl_status_t status() const
+    {
+        return _status;
+    }
+
+    IPAddress localIP() const
+    {
+        return _status == WL_CONNECTED ? IPAddress(127, 0, 0, 1) : IPAddress();
+    }
+
+    void persistent(bool persistent)
+    {
+        (void)persistent;
+    }
+
+    bool setAutoReconnect(bool autoReconnect)
+    {
+        (void)autoReconnect;
+        return true;
+    }
+
+    // host only: pin the station to a status, e.g. WL_DISCONNECTED to test reconnects
+    void SetStatus(wl_status_t status, bool forced = true)
+    {
+        _status = status;
+        _forced = forced;
+    }
+
+private:
+    wl_status_t _status = WL_IDLE_STATUS;
+    bool _forced = false;
+};
+
+extern ESP8266WiFiClass WiFi;
@@ -0,0 +1,38 @@
+// Host stand-in for the ESP8266 core's ESP object, heap and cycle counter.
+// The heap figures come from the glibc malloc arena, so they move the same
+// way as on the chip (allocations, fragmentation) but not with the same
+// values; the cycle counter runs at 80MHz from the host's monotonic clock.
+// The RTC user memory lives as long as the process, like the chip's across
+// a reset; random() replays the same sequence on each run.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+class EspClass
+{
+public:
+    // free bytes in the arena, fragmented or not
+    uint32_t getFreeHeap();
+    // the top chunk of the arena, the largest block malloc can hand out
+    // without asking the system for more
+    uint32_t getMaxFreeBlockSize();
+    // 0 when all the free memory is in one block, towards 100 when it is split
+    uint8_t getHeapFragmentation();
+
+    uint32_t getCycleCount();
+
+    // the hardware random number generator
+    uint32_t random();
+
+    // 512 bytes kept across resets, lost on power loss; `offset` counts
+    // 4 byte blocks, `size` is in bytes
+    bool rtcUserMemoryRead(uint32_t offset, uint32_t *data, size_t size);
+    bool rtcUserMemoryWrite(uint32_t offset, uint32_t *data, size_t size);
+    uint8_t getCpuFreqMHz()
+    {
+        return 80;
+    }
+};
+
+extern EspClass ESP;
@@ -0,0 +1,129 @@
+// Host stand-in for the ESP8266 core filesystem API (File, Dir, FS), backed
+// by a directory of the host: `littlefs/` under the working directory, kept
+// from one run to the next like the flash.
+#pragma once
+
+#include <Arduino.h>
+#include <WString.h>
+
+#include <memory>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+enum SeekMode
+{
+    SeekSet = 0,
+    SeekCur = 1,
+    SeekEnd = 2
+};
+
+class File
+{
+public:
+    File() {}
+    File(FILE *file, const String &name) : _file(file, fclose), _name(name) {}
+
+    size_t write(const uint8_t *buffer, size_t size)
+    {
+        return _file ? fwrite(buffer, 1, size, _file.get()) : 0;
+    }
+    int read()
+    {
+        return _file ? fgetc(_file.get()) : -1;
+    }
+    size_t read(uint8_t *buffer, size_t size)
+    {
+        return _file ? fread(buffer, 1, size, _file.get()) : 0;
+    }
+    bool seek(uint32_t position, SeekMode mode = SeekSet)
+    {
+        return _file && fseek(_file.get(), position, mode) == 0;
+    }
+    size_t position() const
+    {
+        return _file ? ftell(_file.get()) : 0;
+    }
+    size_t size() const;
+    int available() const
+    {
+        return (int)(size() - position());
+    }
+    void close()
+    {
+        _file.reset();
+    }
+    const char *name() const
+    {
+        return _name.c_str();
+    }
+    explicit operator bool() const
+    {
+        return (bool)_file;
+    }
+
+private:
+    std::shared_ptr<FILE> _file;
+    String _name;
+};
+
+// entries of one directory, read when it is opened
+class Dir
+{
+public:
+    Dir() {}
+    Dir(const std::string &path);
+
+    bool next()
+    {
+        return ++_index < (int)_entries.size();
+    }
+    String fileName() const
+    {
+        return String(_entries[_index].Name);
+    }
+    size_t fileSize() const
+    {
+        return _entries[_index].Size;
+    }
+
+private:
+    struct Entry
+    {
+        std::string Name;
+        size_t Size;
+    };
+    std::vector<Entry> _entries;
+    int _index = -1;
+};
+
+struct FSInfo
+{
+    size_t totalBytes;
+    size_t usedBytes;
+    size_t blockSize;
+    size_t pageSize;
+    size_t maxOpenFiles;
+    size_t maxPathLength;
+};
+
+class FS
+{
+public:
+    bool begin();
+    // like LittleFS, opening for writing creates the missing directories
+    File open(const char *path, const char *mode);
+    File open(const String &path, const char *mode)
+    {
+        return open(path.c_str(), mode);
+    }
+    bool exists(const char *path);
+    bool remove(const char *path);
+    bool rename(const char *from, const char *to);
+    Dir openDir(const char *path);
+    // a 1MB flash partition, as with the nodemcuv2 default layout
+    bool info(FSInfo &info);
+
+private:
+    std::string HostPath(const char *path) const;
+};
@@ -0,0 +1,16 @@
+// Host stand-in for the ESP8266 UART: everything goes to stderr.
+#pragma once
+
+#include "Print.h"
+
+class HardwareSerial : public Print
+{
+public:
+    void begin(unsigned long baud) { (void)baud; }
+    void end() {}
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buffer, size_t size) override;
+    using Print::write;
+};
+
+extern HardwareSerial Serial;
@@ -0,0 +1,37 @@
+// Host stand-in for the Arduino IPAddress class
+#pragma once
+
+#include <Arduino.h>
+#include <stdio.h>
+
+class IPAddress : public Printable
+{
+public:
+    IPAddress() : _address{0, 0, 0, 0} {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : _address{a, b, c, d} {}
+    // from an address in network byte order
+    IPAddress(uint32_t address)
+    {
+        memcpy(_address, &address, sizeof(_address));
+    }
+
+    uint8_t operator[](int index) const
+    {
+        return _address[index];
+    }
+
+    String toString() const
+    {
+        char buffer[16];
+        snprintf(buffer, sizeof(buffer), "%u.%u.%u.%u", _address[0], _address[1], _address[2], _address[3]);
+        return String(buffer);
+    }
+
+    size_t printTo(Print &p) const override
+    {
+        return p.print(toString());
+    }
+
+private:
+    uint8_t _address[4];
+};
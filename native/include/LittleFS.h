@@ -0,0 +1,6 @@
+// Host stand-in for the LittleFS instance of the ESP8266 core
+#pragma once
+
+#include <FS.h>
+
+extern FS LittleFS;
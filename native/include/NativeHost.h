@@ -0,0 +1,19 @@
+// Controls that only exist on the host build: they let the benchmark drive
+// time deterministically instead of following the wall clock.
+#pragma once
+
+#include <stdint.h>
+
+namespace NativeHost
+{
+    // when enabled, millis()/micros() only move through AdvanceClock()/delay()
+    void UseVirtualClock(bool enabled);
+    bool IsVirtualClock();
+    void AdvanceClock(uint32_t micros);
+
+    // blocks until micros() reaches `target`, advancing the virtual clock if needed
+    void WaitUntilMicros(uint32_t target);
+
+    // Serial output is written to stderr, it can be muted for benchmarks
+    void MuteSerial(bool muted);
+}
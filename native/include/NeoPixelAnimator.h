@@ -0,0 +1,129 @@
+// Host stand-in for NeoPixelAnimator 2.4.4, same timing semantics:
+// channels are advanced by the elapsed millis() on each UpdateAnimations().
+#pragma once
+
+#include <Arduino.h>
+#include <functional>
+
+enum AnimationState
+{
+    AnimationState_Started,
+    AnimationState_Progress,
+    AnimationState_Completed
+};
+
+struct AnimationParam
+{
+    float progress;
+    uint16_t index;
+    AnimationState state;
+};
+
+typedef std::function<void(const AnimationParam &param)> AnimUpdateCallback;
+
+#define NEO_MILLISECONDS 1
+#define NEO_CENTISECONDS 10
+#define NEO_DECISECONDS 100
+#define NEO_SECONDS 1000
+#define NEO_DECASECONDS 10000
+
+class NeoPixelAnimator
+{
+public:
+    NeoPixelAnimator(uint16_t countAnimations, uint16_t timeScale = NEO_MILLISECONDS);
+    ~NeoPixelAnimator();
+
+    bool IsAnimating() const
+    {
+        return _activeAnimations > 0;
+    }
+
+    bool NextAvailableAnimation(uint16_t *indexAvailable, uint16_t indexStart = 0);
+
+    void StartAnimation(uint16_t indexAnimation, uint16_t duration, AnimUpdateCallback animUpdate);
+    void StopAnimation(uint16_t indexAnimation);
+    void StopAll();
+
+    void RestartAnimation(uint16_t indexAnimation);
+
+    bool IsAnimationActive(uint16_t indexAnimation) const
+    {
+        if (indexAnimation >= _countAnimations)
+        {
+            return false;
+        }
+        return _animations[indexAnimation]._remaining != 0;
+    }
+
+    uint16_t AnimationDuration(uint16_t indexAnimation)
+    {
+        if (indexAnimation >= _countAnimations)
+        {
+            return 0;
+        }
+        return _animations[indexAnimation]._duration;
+    }
+
+    void ChangeAnimationDuration(uint16_t indexAnimation, uint16_t newDuration);
+
+    void UpdateAnimations();
+
+    bool IsPaused() const
+    {
+        return !_isRunning;
+    }
+
+    void Pause()
+    {
+        _isRunning = false;
+    }
+
+    void Resume()
+    {
+        _isRunning = true;
+        _animationLastTick = millis();
+    }
+
+    uint16_t getTimeScale() const
+    {
+        return _timeScale;
+    }
+
+    void setTimeScale(uint16_t timeScale)
+    {
+        _timeScale = (timeScale < 1) ? 1 : (timeScale > 32768) ? 32768 : timeScale;
+    }
+
+private:
+    struct AnimationContext
+    {
+        AnimationContext() : _duration(0), _remaining(0), _fnCallback(nullptr) {}
+
+        void StartAnimation(uint16_t duration)
+        {
+            _duration = duration;
+            _remaining = duration;
+        }
+
+        void StopAnimation()
+        {
+            _remaining = 0;
+        }
+
+        float CurrentProgress()
+        {
+            return (float)(_duration - _remaining) / (float)_duration;
+        }
+
+        uint16_t _duration;
+        uint16_t _remaining;
+        AnimUpdateCallback _fnCallback;
+    };
+
+    uint16_t _countAnimations;
+    AnimationContext *_animations;
+    uint32_t _animationLastTick;
+    uint16_t _activeAnimations;
+    uint16_t _timeScale;
+    bool _isRunning;
+};
@@ -0,0 +1,99 @@
+// Host stand-in for NeoPixelBrightnessBus 2.4.4: colours are scaled by the
+// brightness when stored and rescaled (lossily) when the brightness changes.
+#pragma once
+
+#include "NeoPixelBus.h"
+
+template <typename T_COLOR_FEATURE, typename T_METHOD>
+class NeoPixelBrightnessBus : public NeoPixelBus<T_COLOR_FEATURE, T_METHOD>
+{
+private:
+    typedef NeoPixelBus<T_COLOR_FEATURE, T_METHOD> Base;
+    typedef typename T_COLOR_FEATURE::ColorObject ColorObject;
+
+    static void ConvertColor(ColorObject *color, uint16_t scale)
+    {
+        uint8_t *ptr = (uint8_t *)color;
+        uint8_t *ptrEnd = ptr + sizeof(ColorObject);
+        while (ptr != ptrEnd)
+        {
+            uint16_t value = *ptr;
+            *ptr++ = (value * scale) >> 8;
+        }
+    }
+
+    void ConvertColor(ColorObject *color) const
+    {
+        if (_brightness)
+        {
+            ConvertColor(color, _brightness);
+        }
+    }
+
+    void RecoverColor(ColorObject *color) const
+    {
+        if (_brightness)
+        {
+            uint8_t *ptr = (uint8_t *)color;
+            uint8_t *ptrEnd = ptr + sizeof(ColorObject);
+            while (ptr != ptrEnd)
+            {
+                uint16_t value = *ptr;
+                *ptr++ = (value << 8) / _brightness;
+            }
+        }
+    }
+
+public:
+    NeoPixelBrightnessBus(uint16_t countPixels, uint8_t pin) : Base(countPixels, pin), _brightness(0) {}
+    NeoPixelBrightnessBus(uint16_t countPixels) : Base(countPixels), _brightness(0) {}
+
+    void SetBrightness(uint8_t brightness)
+    {
+        // only update if there is a change
+        if (brightness != GetBrightness())
+        {
+            // the existing pixels are rescaled, this is lossy
+            uint16_t originalBrightness = _brightness ? _brightness : 256;
+            uint16_t scale = (((uint16_t)brightness + 1) << 8) / originalBrightness;
+
+            for (uint16_t indexPixel = 0; indexPixel < Base::PixelCount(); indexPixel++)
+            {
+                ColorObject color = Base::GetPixelColor(indexPixel);
+                ConvertColor(&color, scale);
+                Base::SetPixelColor(indexPixel, color);
+            }
+
+            _brightness = (uint16_t)brightness + 1;
+            Base::Dirty();
+        }
+    }
+
+    uint8_t GetBrightness() const
+    {
+        return _brightness ? _brightness - 1 : 255;
+    }
+
+    void SetPixelColor(uint16_t indexPixel, ColorObject color)
+    {
+        ConvertColor(&color);
+        Base::SetPixelColor(indexPixel, color);
+    }
+
+    ColorObject GetPixelColor(uint16_t indexPixel) const
+    {
+        ColorObject color = Base::GetPixelColor(indexPixel);
+        RecoverColor(&color);
+        return color;
+    }
+
+    void ClearTo(ColorObject color)
+    {
+        ConvertColor(&color);
+        Base::ClearTo(color);
+    }
+
+private:
+    // brightness + 1, 0 while never set (full brightness, no scaling)
+    uint16_t _brightness;
+};
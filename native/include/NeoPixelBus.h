@@ -0,0 +1,502 @@
+// Host stand-in for NeoPixelBus 2.4.4: colour objects, the GRB feature,
+// gamma/easing helpers and a bus whose "wire" is timed against micros()
+// so Show()/CanShow() behave like the ESP8266 DMA method.
+#pragma once
+
+#include <Arduino.h>
+
+struct HslColor;
+struct HtmlColor;
+
+struct RgbColor
+{
+    RgbColor(uint8_t r, uint8_t g, uint8_t b) : R(r), G(g), B(b) {}
+    RgbColor(uint8_t brightness) : R(brightness), G(brightness), B(brightness) {}
+    RgbColor(const HslColor &color);
+    RgbColor(const HtmlColor &color);
+    RgbColor() {}
+
+    bool operator==(const RgbColor &other) const
+    {
+        return R == other.R && G == other.G && B == other.B;
+    }
+    bool operator!=(const RgbColor &other) const
+    {
+        return !(*this == other);
+    }
+
+    uint8_t CalculateBrightness() const
+    {
+        return (uint8_t)(((uint16_t)R + (uint16_t)G + (uint16_t)B) / 3);
+    }
+
+    void Darken(uint8_t delta)
+    {
+        R = R > delta ? R - delta : 0;
+        G = G > delta ? G - delta : 0;
+        B = B > delta ? B - delta : 0;
+    }
+
+    void Lighten(uint8_t delta)
+    {
+        R = R < 255 - delta ? R + delta : 255;
+        G = G < 255 - delta ? G + delta : 255;
+        B = B < 255 - delta ? B + delta : 255;
+    }
+
+    static RgbColor LinearBlend(const RgbColor &left, const RgbColor &right, float progress)
+    {
+        return RgbColor(left.R + ((right.R - left.R) * progress),
+                        left.G + ((right.G - left.G) * progress),
+                        left.B + ((right.B - left.B) * progress));
+    }
+
+    uint8_t R;
+    uint8_t G;
+    uint8_t B;
+};
+
+struct HslColor
+{
+    HslColor(float h, float s, float l) : H(h), S(s), L(l) {}
+    HslColor() {}
+
+    float H;
+    float S;
+    float L;
+};
+
+inline float _HslCalcColor(float p, float q, float t)
+{
+    if (t < 0.0f)
+    {
+        t += 1.0f;
+    }
+    if (t > 1.0f)
+    {
+        t -= 1.0f;
+    }
+    if (t < 1.0f / 6.0f)
+    {
+        return p + (q - p) * 6.0f * t;
+    }
+    if (t < 0.5f)
+    {
+        return q;
+    }
+    if (t < 2.0f / 3.0f)
+    {
+        return p + ((q - p) * (2.0f / 3.0f - t) * 6.0f);
+    }
+    return p;
+}
+
+inline RgbColor::RgbColor(const HslColor &color)
+{
+    float r;
+    float g;
+    float b;
+    float h = color.H;
+    float s = color.S;
+    float l = color.L;
+
+    if (s == 0.0f || l == 0.0f)
+    {
+        r = g = b = l;
+    }
+    else
+    {
+        float temp2 = (l < 0.5f) ? l * (1.0f + s) : l + s - (l * s);
+        float temp1 = 2.0f * l - temp2;
+
+        r = _HslCalcColor(temp1, temp2, h + 1.0f / 3.0f);
+        g = _HslCalcColor(temp1, temp2, h);
+        b = _HslCalcColor(temp1, temp2, h - 1.0f / 3.0f);
+    }
+
+    R = (uint8_t)(r * 255.0f);
+    G = (uint8_t)(g * 255.0f);
+    B = (uint8_t)(b * 255.0f);
+}
+
+struct HtmlColorPair
+{
+    const char *Name;
+    uint32_t Color;
+};
+
+class HtmlColorNames
+{
+public:
+    static const HtmlColorPair *Pair(uint8_t index);
+    static uint8_t Count();
+};
+
+struct HtmlColor
+{
+    HtmlColor(uint32_t color) : Color(color) {}
+    HtmlColor(const RgbColor &color) : Color(((uint32_t)color.R << 16) | ((uint32_t)color.G << 8) | color.B) {}
+    HtmlColor() {}
+
+    // parses "#rrggbb", "#rgb" or a colour name, returns the count of characters consumed
+    template <typename T_HTMLCOLORNAMES>
+    size_t Parse(const char *name, size_t nameSize)
+    {
+        if (nameSize > 0 && name[0] == '#')
+        {
+            size_t digits = 0;
+            uint32_t value = 0;
+            while (digits + 1 < nameSize && isxdigit((unsigned char)name[digits + 1]) && digits < 6)
+            {
+                char c = name[digits + 1];
+                value = (value << 4) | (c <= '9' ? c - '0' : (c | 0x20) - 'a' + 10);
+                digits++;
+            }
+            if (digits == 6)
+            {
+                Color = value;
+                return 7;
+            }
+            if (digits == 3)
+            {
+                Color = ((value & 0xf00) << 12) | ((value & 0xf00) << 8) |
+                        ((value & 0x0f0) << 8) | ((value & 0x0f0) << 4) |
+                        ((value & 0x00f) << 4) | (value & 0x00f);
+                return 4;
+            }
+            return 0;
+        }
+
+        for (uint8_t index = 0; index < T_HTMLCOLORNAMES::Count(); index++)
+        {
+            const HtmlColorPair *pair = T_HTMLCOLORNAMES::Pair(index);
+            size_t length = strlen(pair->Name);
+            if (length <= nameSize && strncasecmp(name, pair->Name, length) == 0)
+            {
+                Color = pair->Color;
+                return length;
+            }
+        }
+        return 0;
+    }
+
+    template <typename T_HTMLCOLORNAMES>
+    size_t Parse(const char *name)
+    {
+        return Parse<T_HTMLCOLORNAMES>(name, strlen(name));
+    }
+
+    template <typename T_HTMLCOLORNAMES>
+    size_t Parse(const String &name)
+    {
+        return Parse<T_HTMLCOLORNAMES>(name.c_str(), name.length());
+    }
+
+    uint32_t Color;
+};
+
+inline RgbColor::RgbColor(const HtmlColor &color)
+    : R((color.Color >> 16) & 0xff), G((color.Color >> 8) & 0xff), B(color.Color & 0xff)
+{
+}
+
+class NeoGrbFeature
+{
+public:
+    typedef RgbColor ColorObject;
+    static const size_t PixelSize = 3;
+
+    static void applyPixelColor(uint8_t *pixels, uint16_t indexPixel, ColorObject color)
+    {
+        uint8_t *p = pixels + indexPixel * PixelSize;
+        *p++ = color.G;
+        *p++ = color.R;
+        *p = color.B;
+    }
+
+    static ColorObject retrievePixelColor(const uint8_t *pixels, uint16_t indexPixel)
+    {
+        const uint8_t *p = pixels + indexPixel * PixelSize;
+        ColorObject color;
+        color.G = *p++;
+        color.R = *p++;
+        color.B = *p;
+        return color;
+    }
+};
+
+// Emulates the ESP8266 DMA method: Update() waits for the previous frame to be
+// clocked out (10us per byte at 800Kbps), then returns while the new one is "sent".
+class NeoNativeMethod
+{
+public:
+    NeoNativeMethod(uint16_t pixelCount, size_t elementSize)
+        : _sizePixels(pixelCount * elementSize), _endTime(0), _updateCount(0)
+    {
+        _pixels = (uint8_t *)calloc(_sizePixels, 1);
+    }
+    ~NeoNativeMethod()
+    {
+        free(_pixels);
+    }
+
+    void Initialize() {}
+
+    bool IsReadyToUpdate() const
+    {
+        return (int32_t)(micros() - _endTime) >= 50;
+    }
+
+    void Update(bool)
+    {
+        NativeHost::WaitUntilMicros(_endTime + 50);
+        _endTime = micros() + WireTimeMicros();
+        _updateCount++;
+    }
+
+    uint32_t WireTimeMicros() const
+    {
+        return (uint32_t)(_sizePixels * 8 * 125 / 100);
+    }
+
+    uint32_t UpdateCount() const
+    {
+        return _updateCount;
+    }
+
+    uint8_t *getPixels() const
+    {
+        return _pixels;
+    }
+
+    size_t getPixelsSize() const
+    {
+        return _sizePixels;
+    }
+
+private:
+    const size_t _sizePixels;
+    uint8_t *_pixels;
+    uint32_t _endTime;
+    uint32_t _updateCount;
+};
+
+typedef NeoNativeMethod NeoEsp8266Dma800KbpsMethod;
+typedef NeoNativeMethod NeoEsp8266Uart800KbpsMethod;
+typedef NeoNativeMethod NeoEsp8266AsyncUart800KbpsMethod;
+typedef NeoNativeMethod Neo800KbpsMethod;
+
+template <typename T_COLOR_FEATURE, typename T_METHOD>
+class NeoPixelBus
+{
+public:
+    NeoPixelBus(uint16_t countPixels, uint8_t pin)
+        : _countPixels(countPixels), _state(0), _method(countPixels, T_COLOR_FEATURE::PixelSize)
+    {
+        (void)pin;
+    }
+
+    NeoPixelBus(uint16_t countPixels)
+        : _countPixels(countPixels), _state(0), _method(countPixels, T_COLOR_FEATURE::PixelSize)
+    {
+    }
+
+    void Begin()
+    {
+        _method.Initialize();
+        Dirty();
+    }
+
+    void Show(bool maintainBufferConsistency = true)
+    {
+        if (!IsDirty())
+        {
+            return;
+        }
+        _method.Update(maintainBufferConsistency);
+        ResetDirty();
+    }
+
+    bool CanShow() const
+    {
+        return _method.IsReadyToUpdate();
+    }
+
+    bool IsDirty() const
+    {
+        return _state & DirtyFlag;
+    }
+
+    void Dirty()
+    {
+        _state |= DirtyFlag;
+    }
+
+    void ResetDirty()
+    {
+        _state &= ~DirtyFlag;
+    }
+
+    uint8_t *Pixels()
+    {
+        return _method.getPixels();
+    }
+
+    size_t PixelsSize() const
+    {
+        return _method.getPixelsSize();
+    }
+
+    size_t PixelSize() const
+    {
+        return T_COLOR_FEATURE::PixelSize;
+    }
+
+    uint16_t PixelCount() const
+    {
+        return _countPixels;
+    }
+
+    void SetPixelColor(uint16_t indexPixel, typename T_COLOR_FEATURE::ColorObject color)
+    {
+        if (indexPixel < _countPixels)
+        {
+            T_COLOR_FEATURE::applyPixelColor(_method.getPixels(), indexPixel, color);
+            Dirty();
+        }
+    }
+
+    typename T_COLOR_FEATURE::ColorObject GetPixelColor(uint16_t indexPixel) const
+    {
+        if (indexPixel < _countPixels)
+        {
+            return T_COLOR_FEATURE::retrievePixelColor(_method.getPixels(), indexPixel);
+        }
+        return typename T_COLOR_FEATURE::ColorObject(0);
+    }
+
+    void ClearTo(typename T_COLOR_FEATURE::ColorObject color)
+    {
+        for (uint16_t indexPixel = 0; indexPixel < _countPixels; indexPixel++)
+        {
+            T_COLOR_FEATURE::applyPixelColor(_method.getPixels(), indexPixel, color);
+        }
+        Dirty();
+    }
+
+    // host only: how many frames actually went out on the emulated wire
+    uint32_t UpdateCount() const
+    {
+        return _method.UpdateCount();
+    }
+
+protected:
+    static const uint8_t DirtyFlag = 1;
+
+    const uint16_t _countPixels;
+    uint8_t _state;
+    T_METHOD _method;
+};
+
+class NeoGammaEquationMethod
+{
+public:
+    static uint8_t Correct(uint8_t value)
+    {
+        return (uint8_t)(255.0f * powf(value / 255.0f, 1.0f / 0.45f) + 0.5f);
+    }
+};
+
+class NeoGammaTableMethod
+{
+public:
+    static uint8_t Correct(uint8_t value)
+    {
+        static const struct Table
+        {
+            Table()
+            {
+                for (uint16_t index = 0; index < 256; index++)
+                {
+                    Values[index] = NeoGammaEquationMethod::Correct(index);
+                }
+            }
+            uint8_t Values[256];
+        } table;
+        return table.Values[value];
+    }
+};
+
+template <typename T_METHOD>
+class NeoGamma
+{
+public:
+    static RgbColor Correct(const RgbColor &original)
+    {
+        return RgbColor(T_METHOD::Correct(original.R),
+                        T_METHOD::Correct(original.G),
+                        T_METHOD::Correct(original.B));
+    }
+};
+
+class NeoEase
+{
+public:
+    static float Linear(float unitValue)
+    {
+        return unitValue;
+    }
+
+    static float QuadraticIn(float unitValue)
+    {
+        return unitValue * unitValue;
+    }
+
+    static float QuadraticOut(float unitValue)
+    {
+        return (-unitValue * (unitValue - 2.0f));
+    }
+
+    static float QuadraticInOut(float unitValue)
+    {
+        unitValue *= 2.0f;
+        if (unitValue < 1.0f)
+        {
+            return (0.5f * unitValue * unitValue);
+        }
+        unitValue -= 1.0f;
+        return (-0.5f * (unitValue * (unitValue - 2.0f) - 1.0f));
+    }
+
+    static float CubicIn(float unitValue)
+    {
+        return (unitValue * unitValue * unitValue);
+    }
+
+    static float CubicOut(float unitValue)
+    {
+        unitValue -= 1.0f;
+        return (unitValue * unitValue * unitValue + 1);
+    }
+
+    static float CubicInOut(float unitValue)
+    {
+        unitValue *= 2.0f;
+        if (unitValue < 1.0f)
+        {
+            return (0.5f * unitValue * unitValue * unitValue);
+        }
+        unitValue -= 2.0f;
+        return (0.5f * (unitValue * unitValue * unitValue + 2.0f));
+    }
+
+    static float ExponentialIn(float unitValue)
+    {
+        return (powf(2, 10.0f * (unitValue - 1.0f)) - 0.001f);
+    }
+
+    static float ExponentialOut(float unitValue)
+    {
+        return (-powf(2, -10.0f * unitValue) + 1.0f);
+    }
+};
@@ -0,0 +1,4 @@
+// Host stand-in for the Time library compatibility header
+#pragma once
+
+#include "TimeLib.h"
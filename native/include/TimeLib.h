@@ -0,0 +1,35 @@
+// Host stand-in for the Time library (TimeLib 1.6), the calendar functions
+// the firmware uses. Times are seconds since 1970 and weekday() is 1 on Sunday.
+#pragma once
+
+#include <Arduino.h>
+#include <time.h>
+
+typedef struct
+{
+    uint8_t Second;
+    uint8_t Minute;
+    uint8_t Hour;
+    uint8_t Wday; // day of week, sunday is day 1
+    uint8_t Day;
+    uint8_t Month;
+    uint8_t Year; // offset from 1970
+} tmElements_t;
+
+#define SECS_PER_MIN ((time_t)(60UL))
+#define SECS_PER_HOUR ((time_t)(3600UL))
+#define SECS_PER_DAY ((time_t)(SECS_PER_HOUR * 24UL))
+#define SECS_PER_WEEK ((time_t)(SECS_PER_DAY * 7UL))
+#define tmYearToCalendar(Y) ((Y) + 1970)
+#define CalendarYrToTm(Y) ((Y)-1970)
+
+void breakTime(time_t time, tmElements_t &tm);
+time_t makeTime(const tmElements_t &tm);
+
+int hour(time_t t);
+int minute(time_t t);
+int second(time_t t);
+int day(time_t t);
+int weekday(time_t t);
+int month(time_t t);
+int year(time_t t);
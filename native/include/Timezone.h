@@ -0,0 +1,75 @@
+// Host stand-in for the Timezone library (JChristensen, 1.2.4), same rules
+// and same computation of the daylight saving time changes.
+#pragma once
+
+#include "TimeLib.h"
+
+enum week_t
+{
+    Last,
+    First,
+    Second,
+    Third,
+    Fourth
+};
+
+enum dow_t
+{
+    Sun = 1,
+    Mon,
+    Tue,
+    Wed,
+    Thu,
+    Fri,
+    Sat
+};
+
+enum month_t
+{
+    Jan = 1,
+    Feb,
+    Mar,
+    Apr,
+    May,
+    Jun,
+    Jul,
+    Aug,
+    Sep,
+    Oct,
+    Nov,
+    Dec
+};
+
+// when the time changes, in local time, and the UTC offset in minutes after it
+struct TimeChangeRule
+{
+    char abbrev[6];
+    uint8_t week;
+    uint8_t dow;
+    uint8_t month;
+    uint8_t hour;
+    int offset;
+};
+
+class Timezone
+{
+public:
+    Timezone(TimeChangeRule dstStart, TimeChangeRule stdStart);
+
+    time_t toLocal(time_t utc);
+    time_t toLocal(time_t utc, TimeChangeRule **tcr);
+    time_t toUTC(time_t local);
+    bool utcIsDST(time_t utc);
+    bool locIsDST(time_t local);
+
+private:
+    void calcTimeChanges(int yr);
+    time_t toTime_t(TimeChangeRule r, int yr);
+
+    TimeChangeRule _dst;
+    TimeChangeRule _std;
+    time_t _dstUTC = 0;
+    time_t _stdUTC = 0;
+    time_t _dstLoc = 0;
+    time_t _stdLoc = 0;
+};
@@ -0,0 +1,78 @@
+// Host stand-in for the Arduino String class, backed by std::string.
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+class String
+{
+public:
+    String() {}
+    String(const char *cstr) : _buffer(cstr ? cstr : "") {}
+    String(const std::string &str) : _buffer(str) {}
+    explicit String(char c) : _buffer(1, c) {}
+    explicit String(int value, unsigned char base = 10);
+    explicit String(unsigned int value, unsigned char base = 10);
+    explicit String(long value, unsigned char base = 10);
+    explicit String(unsigned long value, unsigned char base = 10);
+    explicit String(float value, unsigned char decimalPlaces = 2);
+    explicit String(double value, unsigned char decimalPlaces = 2);
+
+    unsigned int length() const { return _buffer.length(); }
+    const char *c_str() const { return _buffer.c_str(); }
+    bool reserve(unsigned int size)
+    {
+        _buffer.reserve(size);
+        return true;
+    }
+
+    long toInt() const { return strtol(_buffer.c_str(), nullptr, 10); }
+    float toFloat() const { return strtof(_buffer.c_str(), nullptr); }
+
+    bool equals(const String &other) const { return _buffer == other._buffer; }
+    bool equals(const char *other) const { return _buffer == (other ? other : ""); }
+    bool operator==(const String &other) const { return equals(other); }
+    bool operator==(const char *other) const { return equals(other); }
+    bool operator!=(const String &other) const { return !equals(other); }
+    bool operator!=(const char *other) const { return !equals(other); }
+
+    char charAt(unsigned int index) const { return index < _buffer.length() ? _buffer[index] : 0; }
+    char operator[](unsigned int index) const { return charAt(index); }
+    int indexOf(char c, unsigned int from = 0) const;
+    String substring(unsigned int from) const { return substring(from, length()); }
+    String substring(unsigned int from, unsigned int to) const;
+    bool startsWith(const String &prefix) const { return _buffer.compare(0, prefix.length(), prefix._buffer) == 0; }
+    void toUpperCase();
+    void toLowerCase();
+    void trim();
+
+    String &operator+=(const String &rhs)
+    {
+        _buffer += rhs._buffer;
+        return *this;
+    }
+    String &operator+=(const char *rhs)
+    {
+        _buffer += rhs;
+        return *this;
+    }
+    String &operator+=(char rhs)
+    {
+        _buffer += rhs;
+        return *this;
+    }
+    bool concat(const String &rhs)
+    {
+        _buffer += rhs._buffer;
+        return true;
+    }
+
+private:
+    std::string _buffer;
+};
+
+String operator+(const String &lhs, const String &rhs);
+String operator+(const String &lhs, const char *rhs);
+String operator+(const char *lhs, const String &rhs);
+String operator+(const String &lhs, char rhs);
+String operator+(char lhs, const String &rhs);
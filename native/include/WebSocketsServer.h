@@ -0,0 +1,119 @@
+// Host stand-in for WebSocketsServer (links2004/WebSockets): like the web
+// server stand-in there is no socket, clients are connected and their
+// messages injected in-process, and what the sketch sends is captured.
+#pragma once
+
+#include <Arduino.h>
+#include <functional>
+#include <vector>
+
+typedef enum
+{
+    WStype_ERROR,
+    WStype_DISCONNECTED,
+    WStype_CONNECTED,
+    WStype_TEXT,
+    WStype_BIN,
+    WStype_FRAGMENT_TEXT_START,
+    WStype_FRAGMENT_BIN_START,
+    WStype_FRAGMENT,
+    WStype_FRAGMENT_FIN,
+    WStype_PING,
+    WStype_PONG
+} WStype_t;
+
+#define WEBSOCKETS_SERVER_CLIENT_MAX 5
+
+class WebSocketsServer
+{
+public:
+    typedef std::function<void(uint8_t num, WStype_t type, uint8_t *payload, size_t length)> WebSocketServerEvent;
+
+    WebSocketsServer(uint16_t port, String origin = "", String protocol = "arduino") : _port(port)
+    {
+        (void)origin;
+        (void)protocol;
+    }
+
+    void begin() {}
+    void loop() {}
+
+    void onEvent(WebSocketServerEvent event)
+    {
+        _event = event;
+    }
+
+    bool sendTXT(uint8_t num, const char *payload)
+    {
+        return sendBIN(num, (const uint8_t *)payload, strlen(payload));
+    }
+    bool sendBIN(uint8_t num, const uint8_t *payload, size_t length)
+    {
+        if (num >= WEBSOCKETS_SERVER_CLIENT_MAX || !_connected[num])
+        {
+            return false;
+        }
+        _sent.assign(payload, payload + length);
+        _sentCount++;
+        return true;
+    }
+    bool broadcastBIN(const uint8_t *payload, size_t length)
+    {
+        bool sent = false;
+        for (uint8_t num = 0; num < WEBSOCKETS_SERVER_CLIENT_MAX; num++)
+        {
+            sent = sendBIN(num, payload, length) || sent;
+        }
+        return sent;
+    }
+    uint8_t connectedClients(bool ping = false)
+    {
+        (void)ping;
+        uint8_t count = 0;
+        for (bool connected : _connected)
+        {
+            count += connected ? 1 : 0;
+        }
+        return count;
+    }
+
+    // host only: client events and the last message sent to a client
+    void Connect(uint8_t num)
+    {
+        _connected[num] = true;
+        Dispatch(num, WStype_CONNECTED, nullptr, 0);
+    }
+    void Disconnect(uint8_t num)
+    {
+        _connected[num] = false;
+        Dispatch(num, WStype_DISCONNECTED, nullptr, 0);
+    }
+    void Receive(uint8_t num, const std::vector<uint8_t> &message)
+    {
+        std::vector<uint8_t> payload(message);
+        Dispatch(num, WStype_BIN, payload.data(), payload.size());
+    }
+    const std::vector<uint8_t> &LastSent() const
+    {
+        return _sent;
+    }
+    uint32_t SentCount() const
+    {
+        return _sentCount;
+    }
+
+private:
+    void Dispatch(uint8_t num, WStype_t type, uint8_t *payload, size_t length)
+    {
+        if (_event)
+        {
+            _event(num, type, payload, length);
+        }
+    }
+
+    uint16_t _port;
+    WebSocketServerEvent _event;
+    bool _connected[WEBSOCKETS_SERVER_CLIENT_MAX] = {};
+    std::vector<uint8_t> _sent;
+    uint32_t _sentCount = 0;
+};
@@ -0,0 +1,4 @@
+// Host stand-in for the ESP8266 WiFiClient header
+#pragma once
+
+#include <ESP8266WiFi.h>
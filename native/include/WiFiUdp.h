@@ -0,0 +1,63 @@
+// Host stand-in for WiFiUDP on a non-blocking POSIX socket, so the UDP
+// inputs can be driven by a local sender. Like the lwIP version, a received
+// datagram is kept whole until the next parsePacket() and read() consumes it.
+#pragma once
+
+#include <ESP8266WiFi.h>
+
+class WiFiUDP
+{
+public:
+    static const size_t MaxPacketSize = 1472;
+
+    WiFiUDP();
+    ~WiFiUDP();
+
+    // returns 1 when listening on `port`, 0 if the port is taken
+    uint8_t begin(uint16_t port);
+    void stop();
+
+    // receives the next datagram and returns its size, 0 if none is waiting
+    int parsePacket();
+    int available() const
+    {
+        return (int)(_rxSize - _rxPosition);
+    }
+    int read();
+    int read(uint8_t *buffer, size_t length);
+    void flush()
+    {
+        _rxPosition = _rxSize;
+    }
+
+    IPAddress remoteIP() const
+    {
+        return _remoteIP;
+    }
+    uint16_t remotePort() const
+    {
+        return _remotePort;
+    }
+
+    int beginPacket(IPAddress ip, uint16_t port);
+    int beginPacket(const char *host, uint16_t port);
+    size_t write(uint8_t value)
+    {
+        return write(&value, 1);
+    }
+    size_t write(const uint8_t *buffer, size_t size);
+    int endPacket();
+
+private:
+    int _socket;
+    uint8_t _rxBuffer[MaxPacketSize];
+    size_t _rxSize;
+    size_t _rxPosition;
+    IPAddress _remoteIP;
+    uint16_t _remotePort;
+
+    uint8_t _txBuffer[MaxPacketSize];
+    size_t _txSize;
+    uint32_t _txAddress; // network order
+    uint16_t _txPort;
+};
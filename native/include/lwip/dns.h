@@ -0,0 +1,20 @@
+// Host stand-in for the lwIP asynchronous resolver: the host resolves
+// synchronously, so the answer is always given at once (ERR_OK) or not at all.
+#pragma once
+
+#include <stdint.h>
+
+typedef int8_t err_t;
+#define ERR_OK 0
+#define ERR_INPROGRESS -5
+#define ERR_ARG -16
+
+// IPv4 only, in network byte order like lwIP
+typedef struct
+{
+    uint32_t addr;
+} ip_addr_t;
+
+typedef void (*dns_found_callback)(const char *name, const ip_addr_t *ipaddr, void *callback_arg);
+
+err_t dns_gethostbyname(const char *hostname, ip_addr_t *addr, dns_found_callback found, void *callback_arg);
@@ -0,0 +1,168 @@
+// Host implementation of the Arduino core functions declared in Arduino.h
+#include <Arduino.h>
+
+#include <chrono>
+#include <thread>
+#include <stdio.h>
+
+namespace
+{
+    const std::chrono::steady_clock::time_point bootTime = std::chrono::steady_clock::now();
+
+    bool virtualClock = false;
+    uint64_t virtualMicros = 0;
+    bool serialMuted = false;
+
+    // xorshift32, deterministic so benchmark runs are comparable
+    uint32_t randomState = 2463534242u;
+
+    uint64_t nowMicros()
+    {
+        if (virtualClock)
+        {
+            return virtualMicros;
+        }
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::steady_clock::now() - bootTime)
+            .count();
+    }
+
+    uint32_t nextRandom()
+    {
+        randomState ^= randomState << 13;
+        randomState ^= randomState >> 17;
+        randomState ^= randomState << 5;
+        return randomState;
+    }
+}
+
+HardwareSerial Serial;
+
+uint32_t millis()
+{
+    return (uint32_t)(nowMicros() / 1000);
+}
+
+uint32_t micros()
+{
+    return (uint32_t)nowMicros();
+}
+
+void delay(uint32_t ms)
+{
+    delayMicroseconds(ms * 1000);
+}
+
+void delayMicroseconds(uint32_t us)
+{
+    if (virtualClock)
+    {
+        virtualMicros += us;
+    }
+    else
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(us));
+    }
+}
+
+void yield()
+{
+    if (!virtualClock)
+    {
+        std::this_thread::yield();
+    }
+}
+
+long random(long howbig)
+{
+    if (howbig <= 0)
+    {
+        return 0;
+    }
+    return nextRandom() % howbig;
+}
+
+long random(long howsmall, long howbig)
+{
+    if (howsmall >= howbig)
+    {
+        return howsmall;
+    }
+    return howsmall + random(howbig - howsmall);
+}
+
+void randomSeed(unsigned long seed)
+{
+    if (seed != 0)
+    {
+        randomState = (uint32_t)seed;
+    }
+}
+
+int analogRead(uint8_t pin)
+{
+    (void)pin;
+    // a floating pin: a few noisy low bits
+    return nextRandom() & 0x0f;
+}
+
+size_t HardwareSerial::write(uint8_t c)
+{
+    return write(&c, 1);
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size)
+{
+    if (!serialMuted)
+    {
+        fwrite(buffer, 1, size, stderr);
+    }
+    return size;
+}
+
+namespace NativeHost
+{
+    void UseVirtualClock(bool enabled)
+    {
+        if (enabled && !virtualClock)
+        {
+            virtualMicros = nowMicros();
+        }
+        virtualClock = enabled;
+    }
+
+    bool IsVirtualClock()
+    {
+        return virtualClock;
+    }
+
+    void AdvanceClock(uint32_t micros)
+    {
+        virtualMicros += micros;
+    }
+
+    void WaitUntilMicros(uint32_t target)
+    {
+        int32_t remaining = (int32_t)(target - micros());
+        if (remaining <= 0)
+        {
+            return;
+        }
+        if (virtualClock)
+        {
+            virtualMicros += remaining;
+        }
+        else
+        {
+            while ((int32_t)(target - micros()) > 0)
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void MuteSerial(bool muted)
+    {
+        serialMuted = muted;
+    }
+}
@@ -0,0 +1,187 @@
+// Host implementation of the in-process web server
+#include <ESP8266WebServer.h>
+
+namespace
+{
+    String urlDecode(const String &value)
+    {
+        String decoded;
+        for (unsigned int index = 0; index < value.length(); index++)
+        {
+            char c = value[index];
+            if (c == '+')
+            {
+                decoded += ' ';
+            }
+            else if (c == '%' && index + 2 < value.length() && isxdigit((unsigned char)value[index + 1]) && isxdigit((unsigned char)value[index + 2]))
+            {
+                char hex[3] = {value[index + 1], value[index + 2], 0};
+                decoded += (char)strtol(hex, nullptr, 16);
+                index += 2;
+            }
+            else
+            {
+                decoded += c;
+            }
+        }
+        return decoded;
+    }
+}
+
+static const String EmptyArg;
+
+const String &ESP8266WebServer::argName(int index) const
+{
+    return index < (int)_args.size() ? _args[index].Name : EmptyArg;
+}
+
+const String &ESP8266WebServer::arg(int index) const
+{
+    return index < (int)_args.size() ? _args[index].Value : EmptyArg;
+}
+
+const String &ESP8266WebServer::arg(const String &name) const
+{
+    for (const Arg &current : _args)
+    {
+        if (current.Name == name)
+        {
+            return current.Value;
+        }
+    }
+    return EmptyArg;
+}
+
+bool ESP8266WebServer::hasArg(const String &name) const
+{
+    for (const Arg &current : _args)
+    {
+        if (current.Name == name)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ESP8266WebServer::send(int code, const char *contentType, const String &content)
+{
+    _responseCode = code;
+    _responseType = contentType ? contentType : "text/html";
+    _responseBody = content;
+}
+
+void ESP8266WebServer::send(int code, const char *contentType, const char *content, size_t contentLength)
+{
+    _responseCode = code;
+    _responseType = contentType ? contentType : "text/html";
+    _responseBody = String(std::string(content, contentLength));
+}
+
+void ESP8266WebServer::Parse(const char *target, HTTPMethod method)
+{
+    String request(target);
+    int query = request.indexOf('?');
+
+    _currentUri = query < 0 ? request : request.substring(0, query);
+    _currentMethod = method;
+    _args.clear();
+    _responseCode = 0;
+    _responseType = String();
+    _responseBody = String();
+
+    if (query >= 0)
+    {
+        unsigned int start = query + 1;
+        while (start < request.length())
+        {
+            int end = request.indexOf('&', start);
+            String pair = request.substring(start, end < 0 ? request.length() : end);
+            int equals = pair.indexOf('=');
+            if (pair.length())
+            {
+                Arg current;
+                current.Name = urlDecode(equals < 0 ? pair : pair.substring(0, equals));
+                current.Value = equals < 0 ? String() : urlDecode(pair.substring(equals + 1));
+                _args.push_back(current);
+            }
+            start = end < 0 ? request.length() : end + 1;
+        }
+    }
+}
+
+const ESP8266WebServer::Handler *ESP8266WebServer::Find() const
+{
+    for (const Handler &handler : _handlers)
+    {
+        if (handler.Uri == _currentUri && (handler.Method == HTTP_ANY || handler.Method == _currentMethod))
+        {
+            return &handler;
+        }
+    }
+    return nullptr;
+}
+
+int ESP8266WebServer::Request(const char *target, HTTPMethod method)
+{
+    Parse(target, method);
+    const Handler *handler = Find();
+    if (handler)
+    {
+        handler->Function();
+        return _responseCode;
+    }
+
+    if (_notFoundHandler)
+    {
+        _notFoundHandler();
+    }
+    else
+    {
+        send(404, "text/plain", "Not found");
+    }
+    return _responseCode;
+}
+
+int ESP8266WebServer::Upload(const char *target, const uint8_t *data, size_t size, const char *filename, bool abort)
+{
+    Parse(target, HTTP_POST);
+    const Handler *handler = Find();
+    if (!handler || !handler->UploadFunction)
+    {
+        send(404, "text/plain", "Not found");
+        return _responseCode;
+    }
+
+    _upload.status = UPLOAD_FILE_START;
+    _upload.filename = filename;
+    _upload.name = "file";
+    _upload.type = "application/octet-stream";
+    _upload.totalSize = 0;
+    _upload.currentSize = 0;
+    handler->UploadFunction();
+
+    size_t end = abort ? size / 2 : size;
+    for (size_t offset = 0; offset < end; offset += HTTP_UPLOAD_BUFLEN)
+    {
+        _upload.status = UPLOAD_FILE_WRITE;
+        _upload.currentSize = std::min((size_t)HTTP_UPLOAD_BUFLEN, end - offset);
+        memcpy(_upload.buf, data + offset, _upload.currentSize);
+        handler->UploadFunction();
+        _upload.totalSize += _upload.currentSize;
+    }
+
+    if (abort)
+    {
+        // the core calls the upload handler only, no reply can be sent
+        _upload.status = UPLOAD_FILE_ABORTED;
+        handler->UploadFunction();
+        return 0;
+    }
+
+    _upload.status = UPLOAD_FILE_END;
+    _upload.currentSize = 0;
+    handler->UploadFunction();
+    handler->Function();
+    return _responseCode;
+}
@@ -0,0 +1,4 @@
+// Host implementation of the ESP8266 WiFi station
+#include <ESP8266WiFi.h>
+
+ESP8266WiFiClass WiFi;
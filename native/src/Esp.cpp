@@ -0,0 +1,70 @@
+#include <Esp.h>
+
+#include <malloc.h>
+#include <string.h>
+#include <time.h>
+
+EspClass ESP;
+
+namespace
+{
+    const size_t RtcUserMemorySize = 512;
+    uint32_t rtcUserMemory[RtcUserMemorySize / 4];
+
+    uint32_t randomState = 0x9e3779b9u;
+}
+
+uint32_t EspClass::getFreeHeap()
+{
+    return mallinfo2().fordblks;
+}
+
+uint32_t EspClass::getMaxFreeBlockSize()
+{
+    return mallinfo2().keepcost;
+}
+
+uint8_t EspClass::getHeapFragmentation()
+{
+    struct mallinfo2 info = mallinfo2();
+    if (info.fordblks == 0)
+    {
+        return 0;
+    }
+    return 100 - (uint8_t)(info.keepcost * 100 / info.fordblks);
+}
+
+uint32_t EspClass::getCycleCount()
+{
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)((uint64_t)now.tv_sec * 80000000ULL + (uint64_t)now.tv_nsec * 80 / 1000);
+}
+
+uint32_t EspClass::random()
+{
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState;
+}
+
+bool EspClass::rtcUserMemoryRead(uint32_t offset, uint32_t *data, size_t size)
+{
+    if (offset * 4 + size > RtcUserMemorySize)
+    {
+        return false;
+    }
+    memcpy(data, (uint8_t *)rtcUserMemory + offset * 4, size);
+    return true;
+}
+
+bool EspClass::rtcUserMemoryWrite(uint32_t offset, uint32_t *data, size_t size)
+{
+    if (offset * 4 + size > RtcUserMemorySize)
+    {
+        return false;
+    }
+    memcpy((uint8_t *)rtcUserMemory + offset * 4, data, size);
+    return true;
+}
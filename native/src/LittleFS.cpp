@@ -0,0 +1,130 @@
+// Host implementation of the filesystem stand-in, see FS.h
+#include <LittleFS.h>
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+FS LittleFS;
+
+namespace
+{
+    const char *const Root = "littlefs";
+    const size_t TotalBytes = 1024 * 1024;
+
+    void makeParents(const std::string &path)
+    {
+        for (size_t slash = path.find('/'); slash != std::string::npos; slash = path.find('/', slash + 1))
+        {
+            mkdir(path.substr(0, slash).c_str(), 0755);
+        }
+    }
+
+    size_t usedBytes(const std::string &path)
+    {
+        struct stat status;
+        if (stat(path.c_str(), &status) != 0)
+        {
+            return 0;
+        }
+        if (!S_ISDIR(status.st_mode))
+        {
+            return status.st_size;
+        }
+        size_t used = 0;
+        DIR *directory = opendir(path.c_str());
+        while (dirent *entry = directory ? readdir(directory) : nullptr)
+        {
+            if (strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0)
+            {
+                used += usedBytes(path + "/" + entry->d_name);
+            }
+        }
+        if (directory)
+        {
+            closedir(directory);
+        }
+        return used;
+    }
+}
+
+size_t File::size() const
+{
+    struct stat status;
+    return _file && fstat(fileno(_file.get()), &status) == 0 ? status.st_size : 0;
+}
+
+Dir::Dir(const std::string &path)
+{
+    DIR *directory = opendir(path.c_str());
+    if (!directory)
+    {
+        return;
+    }
+    while (dirent *entry = readdir(directory))
+    {
+        struct stat status;
+        std::string entryPath = path + "/" + entry->d_name;
+        if (stat(entryPath.c_str(), &status) == 0 && S_ISREG(status.st_mode))
+        {
+            _entries.push_back({entry->d_name, (size_t)status.st_size});
+        }
+    }
+    closedir(directory);
+}
+
+std::string FS::HostPath(const char *path) const
+{
+    return std::string(Root) + (path[0] == '/' ? "" : "/") + path;
+}
+
+bool FS::begin()
+{
+    mkdir(Root, 0755);
+    return true;
+}
+
+File FS::open(const char *path, const char *mode)
+{
+    std::string hostPath = HostPath(path);
+    if (mode[0] != 'r')
+    {
+        makeParents(hostPath);
+    }
+    // binary and readable, as the flash files are
+    std::string hostMode = std::string(mode) + "b";
+    FILE *file = fopen(hostPath.c_str(), hostMode.c_str());
+    return file ? File(file, String(path)) : File();
+}
+
+bool FS::exists(const char *path)
+{
+    struct stat status;
+    return stat(HostPath(path).c_str(), &status) == 0;
+}
+
+bool FS::remove(const char *path)
+{
+    return ::remove(HostPath(path).c_str()) == 0;
+}
+
+bool FS::rename(const char *from, const char *to)
+{
+    return ::rename(HostPath(from).c_str(), HostPath(to).c_str()) == 0;
+}
+
+Dir FS::openDir(const char *path)
+{
+    return Dir(HostPath(path));
+}
+
+bool FS::info(FSInfo &info)
+{
+    info = {};
+    info.totalBytes = TotalBytes;
+    info.usedBytes = usedBytes(Root);
+    info.blockSize = 4096;
+    info.pageSize = 256;
+    info.maxOpenFiles = 5;
+    info.maxPathLength = 32;
+    return true;
+}
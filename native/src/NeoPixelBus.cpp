@@ -0,0 +1,35 @@
+// Host implementation of the NeoPixelBus colour name table
+#include <NeoPixelBus.h>
+
+namespace
+{
+    const HtmlColorPair colorNames[] PROGMEM = {
+        {"aqua", 0x00ffff},
+        {"black", 0x000000},
+        {"blue", 0x0000ff},
+        {"fuchsia", 0xff00ff},
+        {"gray", 0x808080},
+        {"green", 0x008000},
+        {"lime", 0x00ff00},
+        {"maroon", 0x800000},
+        {"navy", 0x000080},
+        {"olive", 0x808000},
+        {"orange", 0xffa500},
+        {"purple", 0x800080},
+        {"red", 0xff0000},
+        {"silver", 0xc0c0c0},
+        {"teal", 0x008080},
+        {"white", 0xffffff},
+        {"yellow", 0xffff00},
+    };
+}
+
+const HtmlColorPair *HtmlColorNames::Pair(uint8_t index)
+{
+    return &colorNames[index];
+}
+
+uint8_t HtmlColorNames::Count()
+{
+    return sizeof(colorNames) / sizeof(colorNames[0]);
+}
@@ -0,0 +1,84 @@
+// Host implementation of the Arduino Print helpers
+#include <Arduino.h>
+
+#include <stdarg.h>
+#include <stdio.h>
+
+size_t Print::write(const uint8_t *buffer, size_t size)
+{
+    size_t n = 0;
+    while (size--)
+    {
+        n += write(*buffer++);
+    }
+    return n;
+}
+
+size_t Print::write(const char *str)
+{
+    return str ? write((const uint8_t *)str, strlen(str)) : 0;
+}
+
+size_t Print::print(const char *str)
+{
+    return write(str);
+}
+
+size_t Print::print(const String &str)
+{
+    return write((const uint8_t *)str.c_str(), str.length());
+}
+
+size_t Print::print(char c)
+{
+    return write((uint8_t)c);
+}
+
+size_t Print::print(int value, int base)
+{
+    return print(String(value, base));
+}
+
+size_t Print::print(unsigned int value, int base)
+{
+    return print(String(value, base));
+}
+
+size_t Print::print(long value, int base)
+{
+    return print(String(value, base));
+}
+
+size_t Print::print(unsigned long value, int base)
+{
+    return print(String(value, base));
+}
+
+size_t Print::print(double value, int digits)
+{
+    return print(String(value, digits));
+}
+
+size_t Print::print(const Printable &printable)
+{
+    return printable.printTo(*this);
+}
+
+size_t Print::println()
+{
+    return write("\r\n");
+}
+
+size_t Print::printf(const char *format, ...)
+{
+    char buffer[256];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if (length < 0)
+    {
+        return 0;
+    }
+    return write((const uint8_t *)buffer, std::min((size_t)length, sizeof(buffer) - 1));
+}
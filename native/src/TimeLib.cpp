@@ -0,0 +1,67 @@
+#include <TimeLib.h>
+
+void breakTime(time_t time, tmElements_t &tm)
+{
+    struct tm broken;
+    gmtime_r(&time, &broken);
+    tm.Second = broken.tm_sec;
+    tm.Minute = broken.tm_min;
+    tm.Hour = broken.tm_hour;
+    tm.Wday = broken.tm_wday + 1;
+    tm.Day = broken.tm_mday;
+    tm.Month = broken.tm_mon + 1;
+    tm.Year = CalendarYrToTm(broken.tm_year + 1900);
+}
+
+time_t makeTime(const tmElements_t &tm)
+{
+    struct tm broken = {};
+    broken.tm_sec = tm.Second;
+    broken.tm_min = tm.Minute;
+    broken.tm_hour = tm.Hour;
+    broken.tm_mday = tm.Day;
+    broken.tm_mon = tm.Month - 1;
+    broken.tm_year = tmYearToCalendar(tm.Year) - 1900;
+    return timegm(&broken);
+}
+
+int hour(time_t t)
+{
+    return (t % SECS_PER_DAY) / SECS_PER_HOUR;
+}
+
+int minute(time_t t)
+{
+    return (t % SECS_PER_HOUR) / SECS_PER_MIN;
+}
+
+int second(time_t t)
+{
+    return t % SECS_PER_MIN;
+}
+
+int day(time_t t)
+{
+    tmElements_t tm;
+    breakTime(t, tm);
+    return tm.Day;
+}
+
+int weekday(time_t t)
+{
+    return ((t / SECS_PER_DAY + 4) % 7) + 1; // 1970-01-01 was a thursday
+}
+
+int month(time_t t)
+{
+    tmElements_t tm;
+    breakTime(t, tm);
+    return tm.Month;
+}
+
+int year(time_t t)
+{
+    tmElements_t tm;
+    breakTime(t, tm);
+    return tmYearToCalendar(tm.Year);
+}
@@ -0,0 +1,96 @@
+#include <Timezone.h>
+
+Timezone::Timezone(TimeChangeRule dstStart, TimeChangeRule stdStart) : _dst(dstStart), _std(stdStart)
+{
+}
+
+time_t Timezone::toLocal(time_t utc)
+{
+    return utc + (utcIsDST(utc) ? _dst.offset : _std.offset) * SECS_PER_MIN;
+}
+
+time_t Timezone::toLocal(time_t utc, TimeChangeRule **tcr)
+{
+    *tcr = utcIsDST(utc) ? &_dst : &_std;
+    return utc + (*tcr)->offset * SECS_PER_MIN;
+}
+
+time_t Timezone::toUTC(time_t local)
+{
+    return local - (locIsDST(local) ? _dst.offset : _std.offset) * SECS_PER_MIN;
+}
+
+bool Timezone::utcIsDST(time_t utc)
+{
+    if (year(utc) != year(_dstUTC))
+    {
+        calcTimeChanges(year(utc));
+    }
+    if (_stdUTC == _dstUTC)
+    {
+        return false; // no daylight saving time in this zone
+    }
+    if (_stdUTC > _dstUTC)
+    {
+        return utc >= _dstUTC && utc < _stdUTC; // northern hemisphere
+    }
+    return !(utc >= _stdUTC && utc < _dstUTC); // southern hemisphere
+}
+
+bool Timezone::locIsDST(time_t local)
+{
+    if (year(local) != year(_dstLoc))
+    {
+        calcTimeChanges(year(local));
+    }
+    if (_stdUTC == _dstUTC)
+    {
+        return false;
+    }
+    if (_stdLoc > _dstLoc)
+    {
+        return local >= _dstLoc && local < _stdLoc;
+    }
+    return !(local >= _stdLoc && local < _dstLoc);
+}
+
+void Timezone::calcTimeChanges(int yr)
+{
+    _dstLoc = toTime_t(_dst, yr);
+    _stdLoc = toTime_t(_std, yr);
+    _dstUTC = _dstLoc - _std.offset * SECS_PER_MIN;
+    _stdUTC = _stdLoc - _dst.offset * SECS_PER_MIN;
+}
+
+// the time of the change `r` in year `yr`, in local time
+time_t Timezone::toTime_t(TimeChangeRule r, int yr)
+{
+    uint8_t m = r.month;
+    uint8_t w = r.week;
+    if (w == 0)
+    {
+        // Last week: go to the first week of the next month, then back one week
+        if (++m > 12)
+        {
+            m = 1;
+            ++yr;
+        }
+        w = 1;
+    }
+
+    tmElements_t tm;
+    tm.Hour = r.hour;
+    tm.Minute = 0;
+    tm.Second = 0;
+    tm.Day = 1;
+    tm.Month = m;
+    tm.Year = CalendarYrToTm(yr);
+    time_t t = makeTime(tm);
+
+    t += ((r.dow - weekday(t) + 7) % 7 + (w - 1) * 7) * SECS_PER_DAY;
+    if (r.week == 0)
+    {
+        t -= 7 * SECS_PER_DAY;
+    }
+    return t;
+}
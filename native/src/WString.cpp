@@ -0,0 +1,123 @@
+// Host implementation of the Arduino String class
+#include <Arduino.h>
+
+#include <ctype.h>
+#include <stdio.h>
+
+namespace
+{
+    std::string formatInteger(unsigned long value, bool negative, unsigned char base)
+    {
+        char digits[36];
+        char *ptr = digits + sizeof(digits);
+        *--ptr = 0;
+        if (base < 2)
+        {
+            base = 10;
+        }
+        do
+        {
+            unsigned digit = value % base;
+            *--ptr = digit < 10 ? '0' + digit : 'a' + digit - 10;
+            value /= base;
+        } while (value);
+        if (negative)
+        {
+            *--ptr = '-';
+        }
+        return ptr;
+    }
+
+    std::string formatFloat(double value, unsigned char decimalPlaces)
+    {
+        char buffer[48];
+        snprintf(buffer, sizeof(buffer), "%.*f", decimalPlaces, value);
+        return buffer;
+    }
+}
+
+String::String(int value, unsigned char base)
+    : _buffer(formatInteger(value < 0 && base == 10 ? -(long)value : (unsigned int)value, value < 0 && base == 10, base)) {}
+String::String(unsigned int value, unsigned char base) : _buffer(formatInteger(value, false, base)) {}
+String::String(long value, unsigned char base)
+    : _buffer(formatInteger(value < 0 && base == 10 ? -(unsigned long)value : (unsigned long)value, value < 0 && base == 10, base)) {}
+String::String(unsigned long value, unsigned char base) : _buffer(formatInteger(value, false, base)) {}
+String::String(float value, unsigned char decimalPlaces) : _buffer(formatFloat(value, decimalPlaces)) {}
+String::String(double value, unsigned char decimalPlaces) : _buffer(formatFloat(value, decimalPlaces)) {}
+
+int String::indexOf(char c, unsigned int from) const
+{
+    size_t found = _buffer.find(c, from);
+    return found == std::string::npos ? -1 : (int)found;
+}
+
+String String::substring(unsigned int from, unsigned int to) const
+{
+    if (from > to)
+    {
+        std::swap(from, to);
+    }
+    if (from >= _buffer.length())
+    {
+        return String();
+    }
+    return String(_buffer.substr(from, to - from));
+}
+
+void String::toUpperCase()
+{
+    for (char &c : _buffer)
+    {
+        c = toupper((unsigned char)c);
+    }
+}
+
+void String::toLowerCase()
+{
+    for (char &c : _buffer)
+    {
+        c = tolower((unsigned char)c);
+    }
+}
+
+void String::trim()
+{
+    size_t first = _buffer.find_first_not_of(" \t\r\n");
+    size_t last = _buffer.find_last_not_of(" \t\r\n");
+    _buffer = first == std::string::npos ? std::string() : _buffer.substr(first, last - first + 1);
+}
+
+String operator+(const String &lhs, const String &rhs)
+{
+    String result(lhs);
+    result += rhs;
+    return result;
+}
+
+String operator+(const String &lhs, const char *rhs)
+{
+    String result(lhs);
+    result += rhs;
+    return result;
+}
+
+String operator+(const char *lhs, const String &rhs)
+{
+    String result(lhs);
+    result += rhs;
+    return result;
+}
+
+String operator+(const String &lhs, char rhs)
+{
+    String result(lhs);
+    result += rhs;
+    return result;
+}
+
+String operator+(char lhs, const String &rhs)
+{
+    String result(lhs);
+    result += rhs;
+    return result;
+}
@@ -0,0 +1,145 @@
+#include <WiFiUdp.h>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+WiFiUDP::WiFiUDP()
+    : _socket(-1), _rxSize(0), _rxPosition(0), _remotePort(0), _txSize(0), _txAddress(0), _txPort(0)
+{
+}
+
+WiFiUDP::~WiFiUDP()
+{
+    stop();
+}
+
+// the socket is opened on first use, to listen or to send
+static int openSocket()
+{
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd >= 0)
+    {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    }
+    return fd;
+}
+
+uint8_t WiFiUDP::begin(uint16_t port)
+{
+    stop();
+    _socket = openSocket();
+    if (_socket < 0)
+    {
+        return 0;
+    }
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(port);
+    if (bind(_socket, (sockaddr *)&address, sizeof(address)) != 0)
+    {
+        stop();
+        return 0;
+    }
+    return 1;
+}
+
+void WiFiUDP::stop()
+{
+    if (_socket >= 0)
+    {
+        close(_socket);
+        _socket = -1;
+    }
+    _rxSize = _rxPosition = 0;
+}
+
+int WiFiUDP::parsePacket()
+{
+    _rxSize = _rxPosition = 0;
+    if (_socket < 0)
+    {
+        return 0;
+    }
+    sockaddr_in from = {};
+    socklen_t fromLength = sizeof(from);
+    ssize_t received = recvfrom(_socket, _rxBuffer, sizeof(_rxBuffer), 0, (sockaddr *)&from, &fromLength);
+    if (received <= 0)
+    {
+        return 0;
+    }
+    uint32_t remote = ntohl(from.sin_addr.s_addr);
+    _remoteIP = IPAddress(remote >> 24, remote >> 16, remote >> 8, remote);
+    _remotePort = ntohs(from.sin_port);
+    _rxSize = (size_t)received;
+    return (int)_rxSize;
+}
+
+int WiFiUDP::read()
+{
+    return _rxPosition < _rxSize ? _rxBuffer[_rxPosition++] : -1;
+}
+
+int WiFiUDP::read(uint8_t *buffer, size_t length)
+{
+    size_t count = min(length, _rxSize - _rxPosition);
+    memcpy(buffer, _rxBuffer + _rxPosition, count);
+    _rxPosition += count;
+    return (int)count;
+}
+
+int WiFiUDP::beginPacket(IPAddress ip, uint16_t port)
+{
+    _txAddress = htonl(((uint32_t)ip[0] << 24) | ((uint32_t)ip[1] << 16) | ((uint32_t)ip[2] << 8) | ip[3]);
+    _txPort = port;
+    _txSize = 0;
+    return 1;
+}
+
+int WiFiUDP::beginPacket(const char *host, uint16_t port)
+{
+    addrinfo hints = {};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    addrinfo *result = nullptr;
+    if (getaddrinfo(host, nullptr, &hints, &result) != 0 || !result)
+    {
+        return 0;
+    }
+    _txAddress = ((sockaddr_in *)result->ai_addr)->sin_addr.s_addr;
+    freeaddrinfo(result);
+    _txPort = port;
+    _txSize = 0;
+    return 1;
+}
+
+size_t WiFiUDP::write(const uint8_t *buffer, size_t size)
+{
+    size_t count = min(size, sizeof(_txBuffer) - _txSize);
+    memcpy(_txBuffer + _txSize, buffer, count);
+    _txSize += count;
+    return count;
+}
+
+int WiFiUDP::endPacket()
+{
+    if (_socket < 0)
+    {
+        _socket = openSocket();
+        if (_socket < 0)
+        {
+            return 0;
+        }
+    }
+    sockaddr_in to = {};
+    to.sin_family = AF_INET;
+    to.sin_addr.s_addr = _txAddress;
+    to.sin_port = htons(_txPort);
+    ssize_t sent = sendto(_socket, _txBuffer, _txSize, 0, (sockaddr *)&to, sizeof(to));
+    _txSize = 0;
+    return sent >= 0 ? 1 : 0;
+}
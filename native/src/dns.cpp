@@ -0,0 +1,21 @@
+#include <lwip/dns.h>
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+err_t dns_gethostbyname(const char *hostname, ip_addr_t *addr, dns_found_callback found, void *callback_arg)
+{
+    (void)found;
+    (void)callback_arg;
+    addrinfo hints = {};
+    hints.ai_family = AF_INET;
+    addrinfo *result = nullptr;
+    if (getaddrinfo(hostname, nullptr, &hints, &result) != 0 || !result)
+    {
+        return ERR_ARG;
+    }
+    addr->addr = ((sockaddr_in *)result->ai_addr)->sin_addr.s_addr;
+    freeaddrinfo(result);
+    return ERR_OK;
+}
@@ -0,0 +1,20 @@
+// Entry point of the `native` environment: runs the firmware sketch on the host
+#include <Arduino.h>
+
+// the unit tests (`pio test -e native`) have their own main()
+#ifndef PIO_UNIT_TESTING
+
+void setup();
+void loop();
+
+int main()
+{
+    setup();
+    for (;;)
+    {
+        loop();
+        yield();
+    }
+}
+
+#endif
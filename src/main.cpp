@@ -1,17 +1,41 @@
 #include <NeoPixelBus.h>
-#include <NeoPixelBrightnessBus.h>
 #include <NeoPixelAnimator.h>
 
 #include <ESP8266WiFi.h>
 #include <WiFiClient.h>
 #include <ESP8266WebServer.h>
-#include <NTPClient.h>
 #include <WiFiUdp.h>
+#include <WebSocketsServer.h>
+#include <LittleFS.h>
 
 #include <Time.h>
 #include <TimeLib.h>
 #include <Timezone.h>
 
+#include "FixedPoint.h"
+#include "FrameScheduler.h"
+#include "FrameTransition.h"
+#include "JsonWriter.h"
+#include "LayerCompositor.h"
+#include "ClipPlayer.h"
+#include "ControlProtocol.h"
+#include "DdpReceiver.h"
+#include "EffectArena.h"
+#include "ModeDispatcher.h"
+#include "PoleGeometry.h"
+#include "MultiPixelBus.h"
+#include "NtpSync.h"
+#include "Palette.h"
+#include "PhaseTimings.h"
+#include "PrometheusWriter.h"
+#include "StateStore.h"
+#include "WakeSchedule.h"
+#include "WiFiConnection.h"
+#include "effects/GyroEffect.h"
+#include "effects/RowEffects.h"
+#include "effects/Shaders.h"
+#include "effects/VerticalEffect.h"
+
 // replace with your wifi credentials
 const char *ssid = "Livebox-taiti";
 const char *password = "-----";
@@ -19,439 +43,1233 @@ const char *password = "-----";
 // instantiate server at port 80 (http port)
 ESP8266WebServer server(80);
 
+// the control panel keeps a WebSocket open on port 81, see ControlProtocol.h
+WebSocketsServer webSocket(81);
+
 // Total number of pixels
-const uint8_t PixelCount = 240;
+const uint16_t PixelCount = Pole::PixelCount;
 
-// geometry for a zig-zag soldering
-const uint8_t PixelPerRow = 16;
-const uint8_t RowCount = 15;
+// geometry for a zig-zag soldering, see `Pole` in PoleGeometry.h
+const uint8_t PixelPerRow = Pole::ColumnCount;
+const uint8_t RowCount = Pole::RowCount;
 
 // some colors
 const RgbColor black = RgbColor(0, 0, 0);
 const RgbColor white = RgbColor(255, 255, 255);
 const RgbColor red = RgbColor(255, 0, 0);
 
-String ip = "0.0.0.0";
+char ip[16] = "0.0.0.0";
 
-// BOOT, IDLE, GYRO, VERTICAL, WAKEUP
-String status = "BOOT";
+// les modes du poteau, dans l'ordre de la table `modeHandlers`
+enum PoleMode : uint8_t
+{
+    Mode_Boot,
+    Mode_Idle,
+    Mode_Gyro,
+    Mode_Vertical,
+    Mode_Gyro1,
+    Mode_Rainbow,
+    Mode_Rainbow2,
+    Mode_Stripes,
+    Mode_Clip,
+    Mode_Plasma,
+    Mode_Spiral,
+    Mode_Noise,
+    Mode_Count
+};
 
 // Define NTP properties
-#define NTP_OFFSET 60 * 60                // In seconds
-#define NTP_INTERVAL 60 * 1000            // In miliseconds
 #define NTP_ADDRESS "europe.pool.ntp.org" // change this to whatever pool is closest (see ntp.org)
 
-// Set up the NTP UDP client
+// Set up the NTP UDP client, it never waits for the network, see NtpSync.h
 WiFiUDP ntpUDP;
-NTPClient timeClient(ntpUDP, NTP_ADDRESS, NTP_OFFSET, NTP_INTERVAL);
+NtpSync ntp(ntpUDP, NTP_ADDRESS);
+
+// heure de Paris, avec les changements d'heure
+TimeChangeRule CEST = {"CEST", Last, Sun, Mar, 2, 120};
+TimeChangeRule CET = {"CET ", Last, Sun, Oct, 3, 60};
+Timezone localTime(CEST, CET);
 
 // With esp8266, no need to specify the port - the NeoEsp8266Dma800KbpsMethod only supports the RDX0/GPIO3 pin
 // https://github.com/Makuna/NeoPixelBus/wiki/ESP8266-NeoMethods
-NeoPixelBrightnessBus<NeoGrbFeature, Neo800KbpsMethod>
-    strip(PixelCount);
-
-NeoPixelAnimator animations(PixelCount);
+// the frame is stored in linear color, gamma and brightness are applied
+// by Present(), which only pushes frames whose pixels actually changed and
+// hands them to the wire without waiting for the previous one to be out.
+// The outputs are listed in `PoleStrip` (MultiPixelBus.h)
+PoleStrip strip(PixelCount);
 
-NeoGamma<NeoGammaTableMethod> colorGamma; // for any fade animations, best to correct gamma
-
-// keep state for Color Animation
-struct ColorAnimationState
+// the frame is composed from layers, bottom first: the colour set by
+// `?color=` and the fades, the active effect added over it, and the
+// notifications laid over everything
+enum PoleLayerIndex
 {
-    RgbColor StartingColor;
-    RgbColor EndingColor;
+    Layer_Background,
+    Layer_Effect,
+    Layer_Overlay,
+    Layer_Count
 };
+LayerCompositor<PoleStrip, PixelCount, Layer_Count> layers(strip);
+PoleLayer &background = layers.GetLayer(Layer_Background);
+PoleLayer &effectLayer = layers.GetLayer(Layer_Effect);
+PoleLayer &overlay = layers.GetLayer(Layer_Overlay);
+
+// every mode but BOOT and IDLE is an effect, see `modeHandlers`
+typedef EffectArena<Gyro, Gyro1, VerticalEffect, RainbowEffect, Rainbow2Effect, StripesEffect, PlasmaEffect,
+                    RainbowSpiralEffect, NoiseFlowEffect>
+    PoleEffects;
+
+// animation channels: the active effect owns [0, EffectChannelCount), the
+// whole frame fades (color, randomcolor, off) run on the next one
+const uint16_t EffectChannelCount = PoleEffects::ChannelCount;
+const uint16_t TransitionChannel = EffectChannelCount;
+const uint16_t AnimationChannelCount = TransitionChannel + 1;
+NeoPixelAnimator animations(AnimationChannelCount);
 
-// one entry per pixel to match the animation timing manager
-ColorAnimationState colorAnimationState[PixelCount * 2];
+// frames are rendered at a steady rate, `?fps=` changes it
+const uint16_t DefaultFps = 60;
+FrameScheduler scheduler(DefaultFps);
 
-// ---- gyro anim settings
+// temporal dithering of the strip, asked with `?dither=1`: it smooths the
+// fades at a low brightness but needs frames faster than the eye, so asking
+// for it raises the rate to DitherFps, and it is only on while the frames
+// reach the LEDs above DitherMinFps
+const uint16_t DitherFps = FrameScheduler::MaxFps;
+const uint16_t DitherMinFps = 100;
+bool ditherRequested = false;
 
-// fade speed
-const uint16_t GyroPixelFadeDuration = 500;
-// move speed
-const uint16_t GyroNextPixelMoveDuration = 700 / PixelPerRow;
+// frames that reached the wire over the last second: the pushed ones and
+// the ones skipped because nothing changed, they did not wait for it. A
+// frame replaced while the wire was busy never showed, it is not counted
+uint16_t pushedFps = 0;
+uint32_t pushedWindowStart = 0;
+uint32_t pushedWindowFrames = 0;
 
-struct GyroAnimationState
+void handleDithering()
 {
-    RgbColor StartingColor;
-    RgbColor EndingColor;
-    uint16_t IndexPixel; // which pixel this animation is effecting
-};
+    uint32_t now = millis();
+    uint32_t frames = strip.FramesPushed() + strip.FramesSkipped();
+    if (now - pushedWindowStart >= 1000)
+    {
+        pushedFps = (uint64_t)(frames - pushedWindowFrames) * 1000 / (now - pushedWindowStart);
+        pushedWindowStart = now;
+        pushedWindowFrames = frames;
+    }
+    // some margin, a rate around the threshold does not toggle it each second
+    uint16_t minFps = strip.Dithering() ? DitherMinFps - 10 : DitherMinFps;
+    strip.SetDithering(ditherRequested && pushedFps >= minFps);
+}
 
-GyroAnimationState animationState[PixelPerRow / 5 * 2 + 1];
-uint16_t frontPixel = 0; // the front of the loop
-RgbColor frontColor;     // the color at the front of the loop
+FrameTransition<PoleLayer, PixelCount> transition(background);
 
-//--- end gyro
+// pixels streamed by a show controller, see DdpReceiver.h
+WiFiUDP ddpUDP;
+DdpReceiver<PoleStrip, Pole> ddp(strip, ddpUDP);
 
+// the hardware random number generator gives a full 32 bits seed at once,
+// reading the floating analog pin took ten delay(1) at boot
 void SetRandomSeed()
 {
-    uint32_t seed;
+    randomSeed(ESP.random());
+}
 
-    // random works best with a seed that can use 31 bits
-    // analogRead on a unconnected pin tends toward less than four bits
-    seed = analogRead(0);
-    delay(1);
+static const char HtmlPage[] PROGMEM = "<h1>NodeMCU light</h1><a href='https://88wzy9xlnj.codesandbox.io/'>control panel</a>";
 
-    for (int shifts = 3; shifts < 31; shifts += 3)
+// secondes depuis le démarrage, millis() revient à zéro au bout de 49 jours
+uint32_t uptime = 0;
+uint32_t uptimeMillis = 0;
+
+void updateUptime()
+{
+    uint32_t now = millis();
+    if (now - uptimeMillis >= 1000)
     {
-        seed ^= analogRead(0) << shifts;
-        delay(1);
+        uint32_t elapsed = (now - uptimeMillis) / 1000;
+        uptime += elapsed;
+        uptimeMillis += elapsed * 1000;
     }
-
-    // Serial.println(seed);
-    randomSeed(seed);
 }
 
-// simple blend function
-void BlendAnimUpdate(const AnimationParam &param)
-{
-    // this gets called for each animation on every time step
-    // progress will start at 0.0 and end at 1.0
-    // we use the blend function on the RgbColor to mix
-    // color based on the progress given to us in the animation
-    RgbColor updatedColor = RgbColor::LinearBlend(
-        colorAnimationState[param.index].StartingColor,
-        colorAnimationState[param.index].EndingColor,
-        param.progress);
-    // apply the color to the strip
-    strip.SetPixelColor(param.index, updatedColor);
-}
+// ---- HTTP responses
 
-const String HTML_PAGE = "<h1>NodeMCU light</h1><a href='https://88wzy9xlnj.codesandbox.io/'>control panel</a>";
+// every response is written here, the server handles one request at a time
+char responseBuffer[768];
 
-// allume la ligne `rowIndex` avec la couleur `color`
-void allumeLigne(uint16_t rowIndex, RgbColor color)
+void sendJson(int code, const JsonWriter &json)
 {
-    // de 0 à 16
-    for (int count = 0; count < PixelPerRow; count += 1)
+    if (json.Overflowed())
     {
-        // applique la couleur au pixel
-        strip.SetPixelColor((rowIndex * PixelPerRow) + count, color);
+        server.send_P(500, PSTR("application/json"), PSTR("{\"error\":\"response too large\"}"));
+        return;
     }
+    server.send(code, "application/json", json.c_str(), json.Length());
 }
 
-// retourne l'index d'un pixel à partir d'un `rowIndex` et `colIndex`
-int getPixelIndex(uint8_t rowIndex, uint8_t colIndex)
+void sendError(const char *message)
 {
-    return (rowIndex * PixelPerRow) + colIndex;
+    JsonWriter json(responseBuffer);
+    json.BeginObject().Member("error", message).EndObject();
+    sendJson(400, json);
 }
 
-// allume la colonne `colIndex` avec la couleur `color`
-void allumeColonne(uint8_t colIndex, RgbColor color)
+void handlePage()
 {
-    for (int count = 0; count < RowCount; count += 1)
-    {
-        strip.SetPixelColor(getPixelIndex(count, colIndex), color);
-    }
+    server.send_P(200, PSTR("text/html"), HtmlPage);
 }
 
-// applique l'animation à un pixel
-void FadeColorUpdate(const AnimationParam &param)
-{
-    float progress = NeoEase::ExponentialOut(param.progress);
-    RgbColor updatedColor = RgbColor::LinearBlend(
-        colorAnimationState[param.index].StartingColor,
-        colorAnimationState[param.index].EndingColor,
-        progress);
-    strip.SetPixelColor(param.index, updatedColor);
-}
+//--- end HTTP responses
 
-// retourne l'index d'un pixel à partir d'un `rowIndex` et `colIndex`
-// en inversant une ligne sur deux (assemblage zig-zag)
-uint8_t getNormalizedPixelIndex(uint8_t rowIndex, uint8_t colIndex)
+// applique l'animation à toute la trame
+void FrameTransitionUpdate(const AnimationParam &param)
 {
-    const uint8_t offset = rowIndex % 2 == 1 ? PixelPerRow - colIndex - 1 : colIndex;
-    return (rowIndex * PixelPerRow) + offset;
+    transition.Update(param);
 }
 
-// fade a single row
-void fadeRow(uint8_t rowIndex, uint16_t duration, RgbColor color)
+// fixe la couleur cible d'une ligne pour la prochaine transition
+void fadeRow(uint8_t rowIndex, RgbColor color)
 {
+    RgbColor *target = transition.TargetFrame();
     for (int count = 0; count < PixelPerRow; count += 1)
     {
-        uint8_t pixel = getNormalizedPixelIndex(rowIndex, count);
-        colorAnimationState[pixel].StartingColor = strip.GetPixelColor(pixel);
-        colorAnimationState[pixel].EndingColor = color;
-        animations.StartAnimation(pixel, duration, FadeColorUpdate);
+        target[Pole::Index(rowIndex, count)] = color;
     }
 }
 
+// the colour the background fades to, saved with the state
+RgbColor backgroundColor = black;
+
 // allume toutes les leds d'une couleur avec un dégradé par ligne
 void colorize(RgbColor color)
 {
+    backgroundColor = color;
     for (int index = 0; index < RowCount; index += 1)
     {
         //RgbColor color2 = color;
         //color2.Darken(index * 5);
-        fadeRow(index, 300, color);
+        fadeRow(index, color);
     }
+    transition.StartToFrame();
+    animations.StartAnimation(TransitionChannel, 300, FrameTransitionUpdate);
 }
 
 // anime toutes les leds vers une couleur
 void fadeAll(RgbColor color, uint32_t duration = 300)
 {
-    for (uint8_t pixel = 0; pixel < strip.PixelCount(); pixel += 1)
-    {
-        colorAnimationState[pixel].StartingColor = strip.GetPixelColor(pixel);
-        colorAnimationState[pixel].EndingColor = color;
-        animations.StartAnimation(pixel, duration, FadeColorUpdate);
-    }
+    backgroundColor = color;
+    transition.StartToColor(color);
+    animations.StartAnimation(TransitionChannel, duration, FrameTransitionUpdate);
 }
 
-void GyroColumnFadeOut(const AnimationParam &param)
+// ---- modes
+
+void updateAnimations()
 {
-    // this gets called for each animation on every time step
-    // progress will start at 0.0 and end at 1.0
-    // we use the blend function on the RgbColor to mix
-    // color based on the progress given to us in the animation
-    RgbColor updatedColor = RgbColor::LinearBlend(
-        animationState[param.index].StartingColor,
-        animationState[param.index].EndingColor,
-        param.progress);
-    // apply the color to the strip
-    for (uint8_t row = 0; row < RowCount; row++)
+    animations.UpdateAnimations();
+}
+
+// the active effect, the only one holding state
+PoleEffects effects;
+const EffectContext effectContext = {effectLayer, animations, 0};
+
+// the effect starts on its own layer while the background fades out, as
+// the effects used to progressively cover the previous frame
+template <typename T_EFFECT>
+void enterEffect()
+{
+    effectLayer.ClearTo(black);
+    effectLayer.SetOpacity(255);
+    fadeAll(black);
+    effects.Create<T_EFFECT>(effectContext)->Start();
+}
+
+// stops the effect, what it lit stays in the background until the next
+// mode or fade
+void exitEffect()
+{
+    effects.Destroy();
+    layers.MergeDown(Layer_Effect);
+}
+
+// CLIP plays a clip uploaded with POST /clip, streamed from the flash
+ClipPlayer<PoleLayer, Pole> clipPlayer(effectLayer);
+// the clip CLIP plays, chosen with /clip?play=
+char clipPath[32] = "/clips/default.lpc";
+
+void enterClip()
+{
+    effectLayer.ClearTo(black);
+    effectLayer.SetOpacity(255);
+    fadeAll(black);
+    if (!clipPlayer.Start(LittleFS.open(clipPath, "r"), millis()))
     {
-        strip.SetPixelColor(getNormalizedPixelIndex(row, animationState[param.index].IndexPixel),
-                            colorGamma.Correct(updatedColor));
+        Serial.print("Cannot play ");
+        Serial.println(clipPath);
     }
 }
 
-void GyroLoopAnimUpdate(const AnimationParam &param)
+void tickClip()
 {
-    // wait for this animation to complete,
-    // we are using it as a timer of sorts
-    if (param.state == AnimationState_Completed)
-    {
-        // done, time to restart this position tracking animation/timer
-        animations.RestartAnimation(param.index);
+    updateAnimations();
+    clipPlayer.Handle(millis());
+}
 
-        // pick the next pixel inline to start animating
-        //
-        frontPixel = (frontPixel + 1) % PixelPerRow; // increment and wrap
-        if (frontPixel == 0)
-        {
-            // we looped, lets pick a new front color
-            frontColor = HslColor(random(360) / 360.0f, 1.0f, 0.5f);
-        }
+void exitClip()
+{
+    clipPlayer.Stop();
+    layers.MergeDown(Layer_Effect);
+}
 
-        uint16_t indexAnim;
-        // do we have an animation available to use to animate the next front pixel?
-        // if you see skipping, then either you are going to fast or need to increase
-        // the number of animation channels
-        if (animations.NextAvailableAnimation(&indexAnim, 1))
-        {
-            animationState[indexAnim].StartingColor = frontColor;
-            animationState[indexAnim].EndingColor = RgbColor(0, 0, 0);
-            animationState[indexAnim].IndexPixel = frontPixel;
+// BOOT only waits for setup() to end, nothing is animated
+const ModeHandlers modeHandlers[Mode_Count] = {
+    {"BOOT", nullptr, nullptr, nullptr},
+    {"IDLE", nullptr, updateAnimations, nullptr},
+    {"GYRO", enterEffect<Gyro>, updateAnimations, exitEffect},
+    {"VERTICAL", enterEffect<VerticalEffect>, updateAnimations, exitEffect},
+    {"GYRO1", enterEffect<Gyro1>, updateAnimations, exitEffect},
+    {"RAINBOW", enterEffect<RainbowEffect>, updateAnimations, exitEffect},
+    {"RAINBOW2", enterEffect<Rainbow2Effect>, updateAnimations, exitEffect},
+    {"STRIPES", enterEffect<StripesEffect>, updateAnimations, exitEffect},
+    {"CLIP", enterClip, tickClip, exitClip},
+    {"PLASMA", enterEffect<PlasmaEffect>, updateAnimations, exitEffect},
+    {"SPIRAL", enterEffect<RainbowSpiralEffect>, updateAnimations, exitEffect},
+    {"NOISE", enterEffect<NoiseFlowEffect>, updateAnimations, exitEffect},
+};
 
-            animations.StartAnimation(indexAnim, GyroPixelFadeDuration, GyroColumnFadeOut);
-        }
+ModeDispatcher<PoleMode, Mode_Count> modes(modeHandlers, Mode_Boot);
+
+//--- end modes
+
+// lever de soleil : la luminosité monte de 0 à `sunriseTarget` au réveil
+bool sunrise = false;
+uint32_t sunriseStart = 0;
+uint32_t sunriseDuration = 0;
+uint8_t sunriseTarget = 255;
+
+void startSunrise(uint32_t duration)
+{
+    sunriseTarget = strip.GetBrightness() > 0 ? strip.GetBrightness() : 255;
+    sunriseStart = millis();
+    sunriseDuration = duration;
+    sunrise = true;
+    strip.SetBrightness(0);
+}
+
+void handleSunrise()
+{
+    if (!sunrise)
+    {
+        return;
+    }
+    uint32_t elapsed = millis() - sunriseStart;
+    if (elapsed >= sunriseDuration)
+    {
+        strip.SetBrightness(sunriseTarget);
+        sunrise = false;
+    }
+    else
+    {
+        strip.SetBrightness((uint32_t)sunriseTarget * elapsed / sunriseDuration);
     }
 }
 
-RgbColor rowColor;
-uint16_t verticalRowIndex = 1;
-int verticalMoveDuration = 100;
-int verticalFadeDuration = 500;
+// a brightness asked by a panel ends the sunrise
+void setBrightness(uint8_t brightness)
+{
+    sunrise = false;
+    strip.SetBrightness(brightness);
+}
 
-void VerticalLoopAnimUpdate(const AnimationParam &param)
+// éteint le poteau
+void switchOff()
 {
-    // wait for this animation to complete,
-    // we are using it as a timer of sorts
-    if (param.state == AnimationState_Completed)
-    {
+    modes.Switch(Mode_Idle);
+    fadeAll(black, 500);
+}
 
-        // done, time to restart this position tracking animation/timer
-        animations.RestartAnimation(param.index);
+// ---- saved state
 
-        // pick the next pixel inline to start animating
-        if (verticalRowIndex == 0)
-        {
-            // we looped, lets pick a new front color
-            rowColor = HslColor(random(360) / 360.0f, 1.0f, 0.5f);
-        }
+// what the pole shows, saved on each change and restored at boot before
+// the WiFi (StateStore.h)
+struct PoleState
+{
+    uint8_t Mode;
+    uint8_t Brightness;
+    uint16_t Fps;
+    uint8_t Red;
+    uint8_t Green;
+    uint8_t Blue;
+    char Clip[sizeof(clipPath)];
+    // also fills what would be padding, StateStore refuses a state with some
+    uint8_t Dither;
+};
 
-        int previousRowIndex = ((verticalRowIndex == 0) && RowCount) || (verticalRowIndex - 1);
+StateStore<PoleState> stateStore(LittleFS, "/state.bin", "/state.tmp");
 
-        //  fadeRow(previousRowIndex, verticalFadeDuration, black);
-        allumeLigne(verticalRowIndex, rowColor);
-        for (uint8_t i = verticalRowIndex; i >= max(0, verticalRowIndex - 5); i -= 1)
-        {
-            //RgbColor rowColor2 = rowColor;
-            rowColor.Darken(10 * (5 - (i + 1)));
-            allumeLigne(verticalRowIndex - i - 1, rowColor);
-        }
-        verticalRowIndex = (verticalRowIndex + 1) % RowCount; // increment and wrap
+PoleState currentState()
+{
+    PoleState state = {};
+    state.Mode = modes.Current() == Mode_Boot ? Mode_Idle : modes.Current();
+    // a sunrise ends at the brightness it started from
+    state.Brightness = sunrise ? sunriseTarget : strip.GetBrightness();
+    state.Fps = scheduler.Fps();
+    state.Red = backgroundColor.R;
+    state.Green = backgroundColor.G;
+    state.Blue = backgroundColor.B;
+    snprintf(state.Clip, sizeof(state.Clip), "%s", clipPath);
+    state.Dither = ditherRequested;
+    return state;
+}
+
+// shows the saved state at once, without fade
+void restoreState()
+{
+    PoleState state;
+    switch (stateStore.Restore(&state))
+    {
+    case StateStore<PoleState>::Source_Rtc:
+        Serial.println("State restored from RTC memory");
+        break;
+    case StateStore<PoleState>::Source_Flash:
+        Serial.println("State restored from flash");
+        break;
+    case StateStore<PoleState>::Source_None:
+        modes.Switch(Mode_Idle);
+        return;
     }
+
+    strip.SetBrightness(state.Brightness);
+    scheduler.SetFps(state.Fps);
+    ditherRequested = state.Dither != 0;
+    memcpy(clipPath, state.Clip, sizeof(clipPath));
+    clipPath[sizeof(clipPath) - 1] = 0;
+    backgroundColor = RgbColor(state.Red, state.Green, state.Blue);
+    background.ClearTo(backgroundColor);
+    modes.Switch(state.Mode >= Mode_Idle && state.Mode < Mode_Count ? (PoleMode)state.Mode : Mode_Idle);
 }
 
+//--- end saved state
+
 void handleRequest()
 {
     if (server.hasArg("color"))
     {
-        HtmlColor color = HtmlColor();
-        String colorArg = '#' + server.arg("color");
-        color.Parse<HtmlColorNames>(colorArg);
-        Serial.println("Set color: " + colorArg);
+        // "rrggbb", exactly: a longer value would be cut by the buffer
+        const String &value = server.arg("color");
+        HtmlColor color(0);
+        char colorArg[8];
+        bool valid = value.length() == 6 && strspn(value.c_str(), "0123456789abcdefABCDEF") == 6;
+        snprintf(colorArg, sizeof(colorArg), "#%s", value.c_str());
+        if (!valid || color.Parse<HtmlColorNames>(colorArg) != 7)
+        {
+            sendError("bad color");
+            return;
+        }
+        Serial.print("Set color: ");
+        Serial.println(colorArg);
         fadeAll(color);
     }
     else if (server.hasArg("randomcolor"))
     {
-        RgbColor randomColor = HslColor(random(360) / 360.0f, 1.0f, 0.5f);
+        RgbColor randomColor = Palette::RandomHue();
         Serial.println("Set random color");
         colorize(randomColor);
     }
     else if (server.hasArg("off"))
     {
-        animations.StopAnimation(0);
-        animations.StopAnimation(1);
-        frontPixel = 0;
-        verticalRowIndex = 0;
-        status = "IDLE";
-        fadeAll(black, 500);
+        switchOff();
     }
     else if (server.hasArg("brightness"))
     {
-        strip.SetBrightness((server.arg("brightness").toInt()));
+        setBrightness(server.arg("brightness").toInt());
+    }
+    else if (server.hasArg("fps"))
+    {
+        // checked before it is narrowed, 65596 would wrap to 60
+        char *end;
+        long fps = strtol(server.arg("fps").c_str(), &end, 10);
+        if (*end != 0 || fps < FrameScheduler::MinFps || fps > FrameScheduler::MaxFps)
+        {
+            sendError("bad fps");
+            return;
+        }
+        scheduler.SetFps(fps);
+    }
+    else if (server.hasArg("dither"))
+    {
+        ditherRequested = server.arg("dither").toInt() != 0;
+        if (ditherRequested && scheduler.Fps() < DitherFps)
+        {
+            scheduler.SetFps(DitherFps);
+        }
     }
     else if (server.hasArg("fullsteam"))
     {
-        strip.SetBrightness(255);
+        setBrightness(255);
         fadeAll(white);
     }
     else if (server.hasArg("mode"))
     {
-        animations.StopAnimation(0);
-        animations.StopAnimation(1);
-        //strip.ClearTo(black);
-        frontPixel = 0;
-        verticalRowIndex = 0;
+        // BOOT can't be requested
+        PoleMode requested;
+        if (!modes.Parse(server.arg("mode").c_str(), &requested, Mode_Idle))
+        {
+            sendError("unknown mode");
+            return;
+        }
+        modes.Switch(requested);
+    }
+    // the arguments above change the state, a bare "/" only reads it
+    if (server.args() > 0)
+    {
+        stateStore.MarkChanged();
+    }
+
+    JsonWriter json(responseBuffer);
+    json.BeginObject()
+        .Member("control", "https://88wzy9xlnj.codesandbox.io")
+        .Member("ip", ip)
+        .Member("status", modes.Name())
+        .Member("uptime", uptime)
+        .Member("fps", scheduler.Fps())
+        .Member("measuredFps", scheduler.MeasuredFps())
+        .Member("dither", ditherRequested)
+        .Member("dithering", strip.Dithering())
+        .Member("pushedFps", pushedFps)
+        .Member("framesDropped", scheduler.FramesDropped())
+        .Member("framesPushed", strip.FramesPushed())
+        .Member("framesSkipped", strip.FramesSkipped())
+        .Member("framesReplaced", strip.FramesReplaced())
+        .Member("live", ddp.IsLive())
+        .Member("ddpPackets", ddp.PacketsReceived())
+        .Member("ddpDropped", ddp.PacketsDropped())
+        .BeginObject("heap")
+        .Member("free", ESP.getFreeHeap())
+        .Member("maxFreeBlock", ESP.getMaxFreeBlockSize())
+        .Member("fragmentation", ESP.getHeapFragmentation())
+        .EndObject()
+        .EndObject();
+    sendJson(200, json);
+}
+
+// la RAM prise par la trame et les animations, et ce qu'il reste sur le tas
+void handleMemory()
+{
+    // an animator channel is its duration, time remaining and callback
+    const size_t animatorSize = AnimationChannelCount * (2 * sizeof(uint16_t) + sizeof(AnimUpdateCallback));
+    JsonWriter json(responseBuffer);
+    json.BeginObject()
+        .BeginObject("static")
+        .Member("strip", sizeof(strip))
+        .Member("frame", strip.FrameSize())
+        .Member("dither", strip.DitherSize())
+        .Member("outputs", strip.OutputsSize())
+        .Member("transition", sizeof(transition))
+        .Member("effects", sizeof(effects))
+        .Member("layers", sizeof(layers))
+        .Member("clip", sizeof(clipPlayer))
+        .Member("animator", animatorSize)
+        .EndObject()
+        .Member("channels", AnimationChannelCount)
+        .Member("freeHeap", ESP.getFreeHeap())
+        .Member("maxFreeBlock", ESP.getMaxFreeBlockSize())
+        .Member("fragmentation", ESP.getHeapFragmentation())
+        .EndObject();
+    sendJson(200, json);
+}
+
+// ---- timings
+
+// the phases of loop() timed into histograms, Phase_Loop is the whole loop
+enum Phase
+{
+    Phase_WiFi,
+    Phase_Ntp,
+    Phase_Ddp,
+    Phase_Animations,
+    Phase_Compose,
+    Phase_Show,
+    Phase_Http,
+    Phase_WebSocket,
+    Phase_Loop,
+    Phase_Count
+};
+
+const char *const PhaseLabels[Phase_Count] = {
+    "phase=\"wifi\"",
+    "phase=\"ntp\"",
+    "phase=\"ddp\"",
+    "phase=\"animations\"",
+    "phase=\"compose\"",
+    "phase=\"show\"",
+    "phase=\"http\"",
+    "phase=\"websocket\"",
+    "phase=\"loop\""};
 
-        status = server.arg("mode");
-        if (status == "GYRO")
+TimingHistogram timings[Phase_Count];
+
+void sendMetricsChunk(const char *text, size_t length)
+{
+    server.sendContent(text, length);
+}
+
+// Prometheus text format, streamed through responseBuffer in chunks
+void handleMetrics()
+{
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server.send(200, "text/plain; version=0.0.4", "");
+
+    PrometheusWriter metrics(responseBuffer, sizeof(responseBuffer), sendMetricsChunk);
+    metrics.Describe("ledpole_phase_seconds", "histogram", "Duration of the loop() phases.");
+    for (uint8_t phase = 0; phase < Phase_Count; phase++)
+    {
+        metrics.Histogram("ledpole_phase_seconds", PhaseLabels[phase], timings[phase]);
+    }
+    metrics.Describe("ledpole_phase_min_seconds", "gauge", "Shortest run of the phase.");
+    for (uint8_t phase = 0; phase < Phase_Count; phase++)
+    {
+        metrics.SampleSeconds("ledpole_phase_min_seconds", PhaseLabels[phase], timings[phase].MinNanos());
+    }
+    metrics.Describe("ledpole_phase_avg_seconds", "gauge", "Average run of the phase.");
+    for (uint8_t phase = 0; phase < Phase_Count; phase++)
+    {
+        metrics.SampleSeconds("ledpole_phase_avg_seconds", PhaseLabels[phase], timings[phase].AverageNanos());
+    }
+    metrics.Describe("ledpole_phase_p99_seconds", "gauge", "99th percentile of the phase, rounded up to its bucket.");
+    for (uint8_t phase = 0; phase < Phase_Count; phase++)
+    {
+        metrics.SampleSeconds("ledpole_phase_p99_seconds", PhaseLabels[phase], timings[phase].PercentileNanos(99));
+    }
+    metrics.Describe("ledpole_phase_max_seconds", "gauge", "Longest run of the phase.");
+    for (uint8_t phase = 0; phase < Phase_Count; phase++)
+    {
+        metrics.SampleSeconds("ledpole_phase_max_seconds", PhaseLabels[phase], timings[phase].MaxNanos());
+    }
+
+    metrics.Describe("ledpole_frames_rendered_total", "counter", "Frames rendered by the scheduler.");
+    metrics.Sample("ledpole_frames_rendered_total", nullptr, scheduler.FramesRendered());
+    metrics.Describe("ledpole_frames_dropped_total", "counter", "Frames skipped because loop() fell behind.");
+    metrics.Sample("ledpole_frames_dropped_total", nullptr, scheduler.FramesDropped());
+    metrics.Describe("ledpole_frames_late_total", "counter", "Frames rendered half a period or more late.");
+    metrics.Sample("ledpole_frames_late_total", nullptr, scheduler.FramesLate());
+    metrics.Describe("ledpole_frames_replaced_total", "counter", "Frames replaced by a newer one while waiting for the wire.");
+    metrics.Sample("ledpole_frames_replaced_total", nullptr, strip.FramesReplaced());
+    metrics.Describe("ledpole_state_flash_writes_total", "counter", "Saved states written to the flash since boot.");
+    metrics.Sample("ledpole_state_flash_writes_total", nullptr, stateStore.FlashWrites());
+    metrics.Describe("ledpole_state_flash_failures_total", "counter", "Saved states that could not be written, retried later.");
+    metrics.Sample("ledpole_state_flash_failures_total", nullptr, stateStore.FlashFailures());
+    metrics.Describe("ledpole_fps", "gauge", "Frames per second measured over the last second.");
+    metrics.Sample("ledpole_fps", nullptr, scheduler.MeasuredFps());
+    metrics.Describe("ledpole_dithering", "gauge", "1 while the temporal dithering is on.");
+    metrics.Sample("ledpole_dithering", nullptr, strip.Dithering());
+    metrics.Describe("ledpole_free_heap_bytes", "gauge", "Free heap.");
+    metrics.Sample("ledpole_free_heap_bytes", nullptr, ESP.getFreeHeap());
+    metrics.Flush();
+}
+
+// ---- WebSocket control channel
+
+// commands received since the last loop, applied once per loop
+Control::Commands controlCommands;
+// the status last pushed to the panels, pushed again when it changes
+Control::Status lastStatus = {};
+const uint16_t StatusPushInterval = 100;
+uint32_t lastStatusPush = 0;
+
+void webSocketEvent(uint8_t num, WStype_t type, uint8_t *payload, size_t length)
+{
+    switch (type)
+    {
+    case WStype_CONNECTED:
+        // a new panel needs the current status
+        controlCommands.Pending |= Control::Commands::Pending_Status;
+        break;
+    case WStype_BIN:
+        // the protocol does not know the modes, an unknown one is refused
+        // here like `?mode=` does, before it replaces the pending frame
+        if (length >= 2 && payload[0] == Control::Opcode_Mode && (payload[1] < Mode_Idle || payload[1] >= Mode_Count))
         {
-            animations.StartAnimation(0, GyroNextPixelMoveDuration, GyroLoopAnimUpdate);
+            webSocket.sendTXT(num, "{\"error\":\"unknown mode\"}");
         }
-        else if (status == "VERTICAL")
+        else if (!controlCommands.Parse(payload, length))
         {
-            animations.StartAnimation(0, verticalMoveDuration, VerticalLoopAnimUpdate);
+            webSocket.sendTXT(num, "{\"error\":\"unknown command\"}");
         }
+        break;
+    default:
+        break;
     }
-    String JSON_PAGE = "{\"control\":\"https://88wzy9xlnj.codesandbox.io\", \"ip\":\"" + (String)(ip) + "\", \"status\":\"" + status + "\"}";
-    server.send(200, "application/json", JSON_PAGE);
 }
 
-long int lastEvent;
-long int _now = 0;
+void pushStatus(bool force)
+{
+    Control::Status status = {modes.Current(), strip.GetBrightness(), scheduler.Fps(),
+                              ddp.IsLive() ? Control::Status::Flags_Live : (uint8_t)0};
+    uint32_t now = millis();
+    if (force || (status != lastStatus && now - lastStatusPush >= StatusPushInterval))
+    {
+        uint8_t message[Control::Status::Size];
+        status.Write(message);
+        webSocket.broadcastBIN(message, sizeof(message));
+        lastStatus = status;
+        lastStatusPush = now;
+    }
+}
 
-void setup()
+void applyControlCommands()
 {
-    Serial.begin(115200);
-    timeClient.begin();
+    const Control::Commands &commands = controlCommands;
+    if (commands.Has(Control::Commands::Pending_Off))
+    {
+        switchOff();
+    }
+    else if (commands.Has(Control::Commands::Pending_Color))
+    {
+        fadeAll(commands.Color);
+    }
+    else if (commands.Has(Control::Commands::Pending_RandomColor))
+    {
+        colorize(Palette::RandomHue());
+    }
+    else if (commands.Has(Control::Commands::Pending_Mode))
+    {
+        modes.Switch((PoleMode)commands.Mode);
+    }
+    if (commands.Has(Control::Commands::Pending_Brightness))
+    {
+        setBrightness(commands.Brightness);
+    }
+    if (commands.Has(Control::Commands::Pending_Fps))
+    {
+        scheduler.SetFps(commands.Fps);
+    }
+    if (commands.Pending & ~Control::Commands::Pending_Status)
+    {
+        stateStore.MarkChanged();
+    }
+    bool force = commands.Has(Control::Commands::Pending_Status);
+    controlCommands.Pending = 0;
 
-    Serial.print("Starting setup");
-    Serial.println("");
-    SetRandomSeed();
-    strip.Begin();
-    strip.Show();
+    pushStatus(force);
+}
 
-    Serial.println("");
-    Serial.print("Try to connect WiFi");
-    Serial.println("");
+//--- end WebSocket
 
-    WiFi.begin(ssid, password);
+// ---- WiFi
 
-    // Wait WiFi
-    uint32_t counter = 0;
-    while (counter < 100 && WiFi.status() != WL_CONNECTED)
-    {
-        delay(50);
-        Serial.print(".");
-        counter += 1;
-    }
+// la connexion se fait et se refait sans bloquer les animations
+WiFiConnection wifi(ssid, password);
+// red overlay shown while the WiFi never connected since boot
+bool wifiErrorShown = false;
 
-    // WiFi OK
-    if (counter < 100)
+void handleWiFi()
+{
+    switch (wifi.Handle(millis()))
     {
-        Serial.println("");
+    case WiFiConnection::Event_Connected:
         Serial.println("");
         Serial.print("Connected to ");
         Serial.println(ssid);
         Serial.print("IP address: ");
-        ip = WiFi.localIP().toString();
+        {
+            IPAddress address = WiFi.localIP();
+            snprintf(ip, sizeof(ip), "%u.%u.%u.%u", address[0], address[1], address[2], address[3]);
+        }
         Serial.println(ip);
         Serial.println("");
-        //strip.SetBrightness(100);
-        //colorize(RgbColor(0, 150, 0));
-    }
-    else
-    {
-        Serial.println("");
-        Serial.println("");
+        if (wifiErrorShown)
+        {
+            wifiErrorShown = false;
+            overlay.SetOpacity(0);
+        }
+        break;
+    case WiFiConnection::Event_Lost:
+        Serial.println("WiFi lost, reconnecting");
+        break;
+    case WiFiConnection::Event_Failed:
         Serial.print("NOT connected to WiFi ");
         Serial.println(ssid);
-        Serial.println("");
-        strip.SetBrightness(10);
-        colorize(RgbColor(255, 0, 0));
+        if (strcmp(ip, "0.0.0.0") == 0 && !wifiErrorShown)
+        {
+            wifiErrorShown = true;
+            // a dim red veil over whatever is running
+            overlay.ClearTo(RgbColor(255, 0, 0));
+            overlay.SetOpacity(80);
+        }
+        break;
+    case WiFiConnection::Event_None:
+        break;
     }
+}
 
-    strip.Show();
+//--- end WiFi
 
-    server.on("/", handleRequest);
-    server.begin();
-    Serial.println("HTTP server started");
-    status = "IDLE";
+// ---- réveil
+
+// the alarms are edited with /schedule, the first one is the historic 7:30
+WakeSchedule<4> schedule(localTime);
+// the schedule is planned again after each NTP sync
+uint32_t plannedSyncs = 0;
+
+void planSchedule()
+{
+    if (ntp.IsSynced())
+    {
+        schedule.Plan(ntp.Now(millis()));
+    }
 }
 
-uint updateDelay = 60000;
-uint lastElapsed = 0;
+// a wake-up only takes an idle pole
+void wakeUp(const Alarm &alarm)
+{
+    Serial.println("Wake up");
+    if (modes.Current() != Mode_Idle)
+    {
+        return;
+    }
+    modes.Switch((PoleMode)alarm.Mode);
+    if (alarm.Ramp > 0)
+    {
+        startSunrise(alarm.Ramp * 1000UL);
+    }
+    stateStore.MarkChanged();
+}
 
-uint currentHour = 0;
-uint currentMinute = 0;
+void handleClock()
+{
+    uint32_t now = millis();
+    ntp.Handle(now, wifi.IsConnected());
+    if (!ntp.IsSynced())
+    {
+        return;
+    }
+    time_t utc = ntp.Now(now);
+    if (ntp.Syncs() != plannedSyncs)
+    {
+        plannedSyncs = ntp.Syncs();
+        schedule.Plan(utc);
+    }
+    if (schedule.Due(utc))
+    {
+        wakeUp(schedule.Get(schedule.NextIndex()));
+        schedule.Plan(utc);
+    }
+}
 
-void loop()
+// days: ISO weekdays, 1 is monday and 7 sunday, "12345" for the work week
+void weekdaysToString(uint8_t weekdays, char (&days)[8])
+{
+    uint8_t length = 0;
+    for (uint8_t day = 1; day <= 7; day++)
+    {
+        if (weekdays & (1 << (day % 7)))
+        {
+            days[length++] = '0' + day;
+        }
+    }
+    days[length] = 0;
+}
+
+uint8_t weekdaysFromString(const String &days)
 {
-    if (WiFi.status() == WL_CONNECTED) //Check WiFi connection status
+    uint8_t weekdays = 0;
+    for (unsigned int index = 0; index < days.length(); index++)
     {
-        unsigned long elapsed = millis();
-        if (lastElapsed == 0 || elapsed - lastElapsed > updateDelay)
+        if (days[index] >= '1' && days[index] <= '7')
+        {
+            weekdays |= 1 << ((days[index] - '0') % 7);
+        }
+    }
+    return weekdays;
+}
+
+// GET /schedule lists the alarms; with ?index=, the given fields of that
+// alarm change: enabled=0|1, days=12345, time=07:30, mode=GYRO, ramp=600 (s)
+void handleSchedule()
+{
+    if (server.hasArg("index"))
+    {
+        int index = server.arg("index").toInt();
+        if (index < 0 || index >= schedule.Count)
+        {
+            sendError("unknown alarm");
+            return;
+        }
+        Alarm alarm = schedule.Get(index);
+        if (server.hasArg("enabled"))
+        {
+            alarm.Enabled = server.arg("enabled").toInt() != 0;
+        }
+        if (server.hasArg("days"))
+        {
+            alarm.Weekdays = weekdaysFromString(server.arg("days"));
+        }
+        if (server.hasArg("time"))
+        {
+            char *end;
+            long hours = strtol(server.arg("time").c_str(), &end, 10);
+            long minutes = *end == ':' ? strtol(end + 1, &end, 10) : -1;
+            if (hours < 0 || hours > 23 || minutes < 0 || minutes > 59)
+            {
+                sendError("bad time");
+                return;
+            }
+            alarm.Hour = hours;
+            alarm.Minute = minutes;
+        }
+        if (server.hasArg("mode"))
+        {
+            PoleMode mode;
+            if (!modes.Parse(server.arg("mode").c_str(), &mode, Mode_Idle))
+            {
+                sendError("unknown mode");
+                return;
+            }
+            alarm.Mode = mode;
+        }
+        if (server.hasArg("ramp"))
         {
-            Serial.print("Updating NTP");
-            timeClient.update();
-            lastElapsed = elapsed;
-            currentHour = timeClient.getHours();
-            currentMinute = timeClient.getMinutes();
-            if (status == "IDLE" && currentHour == 7 && currentMinute >= 30)
+            // seconds, the range of Alarm::Ramp
+            char *end;
+            long ramp = strtol(server.arg("ramp").c_str(), &end, 10);
+            if (*end != 0 || ramp < 0 || ramp > 0xffff)
             {
-                status = "GYRO";
-                animations.StartAnimation(0, GyroNextPixelMoveDuration, GyroLoopAnimUpdate);
+                sendError("bad ramp");
+                return;
             }
+            alarm.Ramp = ramp;
         }
+        schedule.Set(index, alarm);
+        planSchedule();
+    }
+
+    JsonWriter json(responseBuffer);
+    json.BeginObject().BeginArray("alarms");
+    for (uint8_t index = 0; index < schedule.Count; index++)
+    {
+        const Alarm &alarm = schedule.Get(index);
+        char days[8];
+        weekdaysToString(alarm.Weekdays, days);
+        char time[8];
+        snprintf(time, sizeof(time), "%02u:%02u", alarm.Hour, alarm.Minute);
+        json.BeginObject()
+            .Member("enabled", alarm.Enabled)
+            .Member("days", days)
+            .Member("time", time)
+            .Member("mode", modes.Name((PoleMode)alarm.Mode))
+            .Member("ramp", alarm.Ramp)
+            .EndObject();
+    }
+    json.EndArray();
+    if (schedule.Next() == schedule.Never)
+    {
+        json.MemberNull("next");
+    }
+    else
+    {
+        json.Member("next", (uint32_t)schedule.Next());
+    }
+    json.EndObject();
+    sendJson(200, json);
+}
+
+//--- end réveil
+
+// ---- clips
+
+const uint8_t ClipNameLength = 16;
+
+// a clip name makes its file name, "/clips/<name>.<extension>"
+bool clipPathOf(const String &name, const char *extension, char *path, size_t size)
+{
+    if (name.length() == 0 || name.length() > ClipNameLength)
+    {
+        return false;
+    }
+    for (unsigned int index = 0; index < name.length(); index++)
+    {
+        char c = name[index];
+        if (!isalnum(c) && c != '-' && c != '_')
+        {
+            return false;
+        }
+    }
+    snprintf(path, size, "/clips/%s.%s", name.c_str(), extension);
+    return true;
+}
+
+// an upload is written to a temporary file, which replaces the clip once
+// it is complete and valid
+File clipUpload;
+bool clipUploadFailed = false;
+
+void handleClipUpload()
+{
+    HTTPUpload &upload = server.upload();
+    char temporary[32];
+    if (!clipPathOf(server.arg("name"), "tmp", temporary, sizeof(temporary)))
+    {
+        clipUploadFailed = true;
+        return;
+    }
+    switch (upload.status)
+    {
+    case UPLOAD_FILE_START:
+        clipUpload = LittleFS.open(temporary, "w");
+        clipUploadFailed = !clipUpload;
+        break;
+    case UPLOAD_FILE_WRITE:
+        if (clipUpload && clipUpload.write(upload.buf, upload.currentSize) != upload.currentSize)
+        {
+            // the flash is full
+            clipUploadFailed = true;
+        }
+        break;
+    case UPLOAD_FILE_END:
+        clipUpload.close();
+        break;
+    case UPLOAD_FILE_ABORTED:
+        clipUpload.close();
+        LittleFS.remove(temporary);
+        break;
+    }
+}
+
+// POST /clip?name=show with the file as multipart/form-data
+void handleClipUploaded()
+{
+    char temporary[32];
+    char path[32];
+    if (!clipPathOf(server.arg("name"), "tmp", temporary, sizeof(temporary)) ||
+        !clipPathOf(server.arg("name"), "lpc", path, sizeof(path)))
+    {
+        sendError("bad name");
+        return;
     }
-    else // attempt to connect to wifi again if disconnected
+
+    Clip::Header header;
+    File file = LittleFS.open(temporary, "r");
+    bool valid = !clipUploadFailed && file && ClipPlayer<PoleLayer, Pole>::ReadHeader(file, &header);
+    file.close();
+    if (!valid)
     {
-        Serial.print("Reconnecting wifi....");
-        WiFi.begin(ssid, password);
+        LittleFS.remove(temporary);
+        sendError(clipUploadFailed ? "upload failed" : "not a clip of this pole");
+        return;
+    }
 
-        delay(1000);
+    // the clip playing is being replaced
+    if (modes.Current() == Mode_Clip && strcmp(path, clipPath) == 0)
+    {
+        modes.Switch(Mode_Idle);
+        stateStore.MarkChanged();
     }
-    if (status == "IDLE")
+    LittleFS.remove(path);
+    LittleFS.rename(temporary, path);
+
+    JsonWriter json(responseBuffer);
+    json.BeginObject()
+        .Member("name", server.arg("name").c_str())
+        .Member("frames", header.FrameCount)
+        .Member("fps", header.Fps)
+        .EndObject();
+    sendJson(200, json);
+}
+
+// GET /clip lists the clips; ?play=show plays one, ?delete=show removes it
+void handleClip()
+{
+    char path[32];
+    if (server.hasArg("play") || server.hasArg("delete"))
     {
-        //Serial.print("IDLE");
-        animations.UpdateAnimations();
+        const String &name = server.arg(server.hasArg("play") ? "play" : "delete");
+        if (!clipPathOf(name, "lpc", path, sizeof(path)) || !LittleFS.exists(path))
+        {
+            sendError("unknown clip");
+            return;
+        }
+        bool playing = modes.Current() == Mode_Clip && strcmp(path, clipPath) == 0;
+        if (server.hasArg("play"))
+        {
+            strcpy(clipPath, path);
+            modes.Switch(Mode_Clip);
+        }
+        else
+        {
+            if (playing)
+            {
+                modes.Switch(Mode_Idle);
+            }
+            LittleFS.remove(path);
+        }
+        stateStore.MarkChanged();
     }
-    else if (status == "GYRO")
+
+    JsonWriter json(responseBuffer);
+    json.BeginObject().BeginArray("clips");
+    Dir dir = LittleFS.openDir("/clips");
+    while (dir.next())
     {
-        //Serial.print("GYRO");
-        animations.UpdateAnimations();
+        // "show.lpc", the temporary files of the uploads are left out
+        String fileName = dir.fileName();
+        const char *extension = strrchr(fileName.c_str(), '.');
+        if (!extension || strcmp(extension, ".lpc") != 0)
+        {
+            continue;
+        }
+        char name[ClipNameLength + 1];
+        snprintf(name, sizeof(name), "%.*s", (int)(extension - fileName.c_str()), fileName.c_str());
+        json.BeginObject().Member("name", name).Member("size", (uint32_t)dir.fileSize()).EndObject();
     }
-    else if (status == "VERTICAL")
+    json.EndArray();
+    if (modes.Current() == Mode_Clip && clipPlayer.IsPlaying())
     {
-        //Serial.print("VERTICAL");
-        animations.UpdateAnimations();
+        // "/clips/" is left out
+        char name[ClipNameLength + 1];
+        snprintf(name, sizeof(name), "%.*s", (int)(strlen(clipPath) - 11), clipPath + 7);
+        json.Member("playing", name).Member("frame", clipPlayer.Frame());
     }
+    else
+    {
+        json.MemberNull("playing");
+    }
+    FSInfo info;
+    if (LittleFS.info(info))
+    {
+        json.Member("free", (uint32_t)(info.totalBytes - info.usedBytes));
+    }
+    json.EndObject();
+    sendJson(200, json);
+}
+
+//--- end clips
 
-    server.handleClient();
+long int lastEvent;
+long int _now = 0;
+
+void setup()
+{
+    Serial.begin(115200);
+    Serial.print("Starting setup");
+    Serial.println("");
+    SetRandomSeed();
+    if (!LittleFS.begin())
+    {
+        Serial.println("LittleFS not mounted, no clips nor saved state");
+    }
+
+    // the first frame is what was showing before the reset
+    effectLayer.SetBlend(LayerBlend_Add);
+    effectLayer.SetOpacity(0);
+    overlay.SetOpacity(0);
+    strip.Begin();
+    restoreState();
+    layers.Compose();
     strip.Show();
+    Serial.print("First frame at ");
+    Serial.print(millis());
+    Serial.println("ms");
+
+    ntp.Begin();
+    // only the historic 7:30 GYRO is enabled, the others are templates
+    for (uint8_t index = 0; index < schedule.Count; index++)
+    {
+        schedule.Set(index, {index == 0, schedule.EveryDay, 7, 30, Mode_Gyro, 0});
+    }
+
+    Serial.println("");
+    Serial.print("Try to connect WiFi");
+    Serial.println("");
+    // the frames go on meanwhile, the connection is made by loop()
+    wifi.Begin(millis());
+
+    server.on("/", handleRequest);
+    server.on("/index.html", handlePage);
+    server.on("/memory", handleMemory);
+    server.on("/schedule", handleSchedule);
+    server.on("/metrics", handleMetrics);
+    server.on("/clip", HTTP_POST, handleClipUploaded, handleClipUpload);
+    server.on("/clip", HTTP_GET, handleClip);
+    server.begin();
+    Serial.println("HTTP server started");
+    webSocket.begin();
+    webSocket.onEvent(webSocketEvent);
+    if (ddp.Begin())
+    {
+        Serial.println("DDP listening on UDP 4048");
+    }
+    scheduler.Reset();
+}
+
+void loop()
+{
+    ScopedTiming loopTiming(timings[Phase_Loop]);
+    updateUptime();
+    {
+        ScopedTiming timing(timings[Phase_WiFi]);
+        handleWiFi();
+    }
+    {
+        ScopedTiming timing(timings[Phase_Ntp]);
+        handleClock();
+    }
+
+    // while a show controller streams pixels, it pushes the frames and the
+    // effects and fades are paused where they are
+    bool wasLive = ddp.IsLive();
+    {
+        ScopedTiming timing(timings[Phase_Ddp]);
+        ddp.Handle(millis());
+    }
+    if (ddp.IsLive() != wasLive)
+    {
+        if (ddp.IsLive())
+        {
+            Serial.println("DDP live");
+            animations.Pause();
+        }
+        else
+        {
+            Serial.println("DDP ended");
+            animations.Resume();
+            layers.Invalidate();
+            // the frames not rendered while live were not dropped
+            scheduler.Reset();
+        }
+    }
+
+    // a frame presented while the previous one was on the wire goes out
+    // as soon as the wire is free
+    if (strip.Staged() && strip.CanShow())
+    {
+        ScopedTiming timing(timings[Phase_Show]);
+        strip.Flush();
+    }
+
+    // between two frames, loop() only serves the network; while live no
+    // frame is due, the stream is not counted as rendered frames
+    if (!ddp.IsLive() && scheduler.FrameDue())
+    {
+        {
+            ScopedTiming timing(timings[Phase_Animations]);
+            handleSunrise();
+            modes.Tick();
+        }
+        {
+            ScopedTiming timing(timings[Phase_Compose]);
+            layers.Compose();
+        }
+        ScopedTiming timing(timings[Phase_Show]);
+        handleDithering();
+        strip.Present();
+    }
+
+    {
+        ScopedTiming timing(timings[Phase_Http]);
+        server.handleClient();
+    }
+    {
+        ScopedTiming timing(timings[Phase_WebSocket]);
+        webSocket.loop();
+        applyControlCommands();
+    }
+    stateStore.Handle(millis(), currentState);
 }
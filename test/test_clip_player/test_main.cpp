@@ -0,0 +1,163 @@
+// Plays a clip made by tools/clip_encode.py through the player that runs on
+// the pole, `pio test -e native`. clip.rgb holds the source frames (15 rows
+// of 16 RGB pixels from the bottom left, like --raw reads them), clip.lpc
+// the clip the tool made of them:
+//
+//   tools/clip_encode.py test/test_clip_player/clip.lpc
+//       --raw test/test_clip_player/clip.rgb --fps 30 --keyframe-interval 8
+//
+// The frames have flat areas for the repeat runs, a band moving up for the
+// literal runs and the skips of the deltas, and every 10th frame is noise, a
+// keyframe longer than the ring of the player. Encode clip.lpc again when
+// the tool or the format changes.
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <NeoPixelBus.h>
+#include <unity.h>
+
+#include <stdio.h>
+#include <vector>
+
+#include "ClipPlayer.h"
+#include "LayerCompositor.h"
+#include "PoleGeometry.h"
+
+namespace
+{
+    // the tests run from the project directory, like the LittleFS stand-in
+    const char *const SourcePath = "test/test_clip_player/clip.rgb";
+    const char *const FixturePath = "test/test_clip_player/clip.lpc";
+    const char *const ClipPath = "/clips/test.lpc";
+    // the start of the clip on the clock, in ms
+    const uint32_t Start = 1000;
+    // the jumps of the second test, about 7 frames at 30 fps
+    const uint32_t JumpMillis = 233;
+
+    typedef ClipPlayer<PoleLayer, Pole> Player;
+    typedef std::vector<RgbColor> Frame;
+
+    std::vector<uint8_t> readHostFile(const char *path)
+    {
+        std::vector<uint8_t> bytes;
+        FILE *file = fopen(path, "rb");
+        if (!file)
+        {
+            return bytes;
+        }
+        uint8_t buffer[512];
+        size_t length;
+        while ((length = fread(buffer, 1, sizeof(buffer), file)) > 0)
+        {
+            bytes.insert(bytes.end(), buffer, buffer + length);
+        }
+        fclose(file);
+        return bytes;
+    }
+
+    std::vector<Frame> frames;
+    Clip::Header header;
+
+    bool matches(const PoleLayer &canvas, const Frame &frame)
+    {
+        for (uint16_t pixel = 0; pixel < Pole::PixelCount; pixel++)
+        {
+            uint16_t index = Pole::Index(pixel / Pole::ColumnCount, pixel % Pole::ColumnCount);
+            if (canvas.GetPixelColor(index) != frame[pixel])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // plays the clip at the times given by `next` for `count` steps and
+    // returns the frames that differ from their source; `next(step)` is the
+    // clock of the step, in ms
+    template <typename T_NEXT>
+    uint32_t play(uint32_t count, T_NEXT next)
+    {
+        PoleLayer canvas;
+        Player player(canvas);
+        TEST_ASSERT_TRUE(player.Start(LittleFS.open(ClipPath, "r"), Start));
+        uint32_t mismatches = 0;
+        for (uint32_t step = 0; step < count; step++)
+        {
+            uint32_t now = next(step);
+            player.Handle(now);
+
+            // the frame due at `now`, the clip loops
+            uint32_t due = (uint64_t)(now - Start) * header.Fps / 1000 % header.FrameCount;
+            if (!player.IsPlaying() || !matches(canvas, frames[due]))
+            {
+                mismatches++;
+            }
+        }
+        player.Stop();
+        return mismatches;
+    }
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+void test_header()
+{
+    File file = LittleFS.open(ClipPath, "r");
+    TEST_ASSERT_TRUE(Player::ReadHeader(file, &header));
+    file.close();
+    TEST_ASSERT_EQUAL_UINT8(30, header.Fps);
+    TEST_ASSERT_EQUAL_UINT16(8, header.KeyframeInterval);
+    TEST_ASSERT_EQUAL_UINT16(frames.size(), header.FrameCount);
+}
+
+// each frame at its own time, twice around the loop
+void test_sequential()
+{
+    uint32_t fps = header.Fps;
+    TEST_ASSERT_EQUAL_UINT32(0, play(header.FrameCount * 2, [fps](uint32_t step) {
+        return Start + (step * 1000 + fps - 1) / fps;
+    }));
+}
+
+// jumps of several frames, across the keyframes, three times around
+void test_jumps()
+{
+    TEST_ASSERT_EQUAL_UINT32(0, play(header.FrameCount * 3 * 1000 / header.Fps / JumpMillis, [](uint32_t step) {
+        return Start + (step + 1) * JumpMillis;
+    }));
+}
+
+int main()
+{
+    std::vector<uint8_t> source = readHostFile(SourcePath);
+    for (size_t offset = 0; offset + Pole::PixelCount * 3 <= source.size(); offset += Pole::PixelCount * 3)
+    {
+        Frame frame;
+        for (uint16_t pixel = 0; pixel < Pole::PixelCount; pixel++)
+        {
+            const uint8_t *color = &source[offset + pixel * 3];
+            frame.push_back(RgbColor(color[0], color[1], color[2]));
+        }
+        frames.push_back(frame);
+    }
+    std::vector<uint8_t> clip = readHostFile(FixturePath);
+    LittleFS.begin();
+    File file = LittleFS.open(ClipPath, "w");
+    file.write(clip.data(), clip.size());
+    file.close();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_header);
+    if (header.FrameCount == frames.size() && !frames.empty())
+    {
+        RUN_TEST(test_sequential);
+        RUN_TEST(test_jumps);
+    }
+    LittleFS.remove(ClipPath);
+    return UNITY_END();
+}
@@ -0,0 +1,209 @@
+#!/usr/bin/env python3
+"""Encodes a clip for the CLIP mode (format in include/ClipPlayer.h).
+
+    tools/clip_encode.py OUTPUT (--raw FILE | --pattern rainbow|plasma)
+                         [--fps 30] [--frames 300] [--keyframe-interval 30]
+                         [--verify] [--upload HOST --name NAME]
+
+--raw reads frames of 15 rows of 16 RGB pixels (720 bytes each), rows from
+the bottom and columns from the left like the DDP stream, e.g. exported with
+`ffmpeg -i show.mp4 -vf scale=16:15,vflip -f rawvideo -pix_fmt rgb24 show.rgb`.
+--pattern renders a built-in animation of --frames frames instead.
+--verify decodes the clip it wrote and checks every frame against the
+source, the round trip of the encoder and the decoding rules of the player.
+--upload sends the clip to the pole, then `/clip?play=NAME` plays it:
+    curl -F file=@show.lpc 'http://HOST/clip?name=show'
+"""
+import argparse
+import colorsys
+import math
+import struct
+import sys
+import urllib.request
+import uuid
+
+ROWS, COLUMNS = 15, 16
+PIXELS = ROWS * COLUMNS
+MAGIC = b"LPC1"
+RECORD_KEY, RECORD_DELTA = ord("K"), ord("D")
+RUN_SKIP, RUN_LITERAL, RUN_REPEAT = 0x00, 0x40, 0x80
+MAX_SKIP, MAX_LITERAL, MAX_REPEAT = 64, 64, 128
+
+
+def pattern_frames(name, count):
+    for step in range(count):
+        frame = bytearray()
+        for row in range(ROWS):
+            for column in range(COLUMNS):
+                if name == "rainbow":
+                    hue = ((row + step * 0.25) % ROWS) / ROWS
+                    r, g, b = colorsys.hsv_to_rgb(hue, 1.0, 0.5)
+                else:
+                    angle = 2 * math.pi * column / COLUMNS
+                    value = (math.sin(angle * 2 + step * 0.1) + math.sin(row * 0.4 - step * 0.07)) / 4 + 0.5
+                    r, g, b = colorsys.hsv_to_rgb(value, 1.0, value)
+                frame += bytes((int(r * 255), int(g * 255), int(b * 255)))
+        yield bytes(frame)
+
+
+def raw_frames(path):
+    with open(path, "rb") as source:
+        while True:
+            frame = source.read(PIXELS * 3)
+            if len(frame) < PIXELS * 3:
+                return
+            yield frame
+
+
+def pixel(frame, index):
+    return frame[index * 3:index * 3 + 3]
+
+
+def encode_frame(frame, previous):
+    """Runs of `frame`; with `previous`, unchanged pixels are skipped."""
+    payload = bytearray()
+    index = 0
+    while index < PIXELS:
+        if previous is not None and pixel(frame, index) == pixel(previous, index):
+            count = 1
+            while (index + count < PIXELS and count < MAX_SKIP
+                   and pixel(frame, index + count) == pixel(previous, index + count)):
+                count += 1
+            payload.append(RUN_SKIP | (count - 1))
+            index += count
+            continue
+
+        count = 1
+        while (index + count < PIXELS and count < MAX_REPEAT
+               and pixel(frame, index + count) == pixel(frame, index)):
+            count += 1
+        if count >= 2:
+            payload.append(RUN_REPEAT | (count - 1))
+            payload += pixel(frame, index)
+            index += count
+            continue
+
+        # literal pixels up to the next run worth its own code
+        start = index
+        index += 1
+        while index < PIXELS and index - start < MAX_LITERAL:
+            if previous is not None and pixel(frame, index) == pixel(previous, index):
+                break
+            if index + 1 < PIXELS and pixel(frame, index) == pixel(frame, index + 1):
+                break
+            index += 1
+        payload.append(RUN_LITERAL | (index - start - 1))
+        payload += frame[start * 3:index * 3]
+    return bytes(payload)
+
+
+def encode(frames, fps, keyframe_interval):
+    records = bytearray()
+    previous = None
+    count = 0
+    for index, frame in enumerate(frames):
+        key = encode_frame(frame, None)
+        if index % keyframe_interval == 0:
+            record_type, payload = RECORD_KEY, key
+        else:
+            delta = encode_frame(frame, previous)
+            record_type, payload = (RECORD_DELTA, delta) if len(delta) < len(key) else (RECORD_KEY, key)
+        records += struct.pack("<BH", record_type, len(payload)) + payload
+        previous = frame
+        count += 1
+    if count == 0 or count > 0xFFFF:
+        raise ValueError("a clip holds 1 to 65535 frames, not %d" % count)
+    header = MAGIC + struct.pack("<BBBBHHI", ROWS, COLUMNS, fps, 0, count, keyframe_interval, 0)
+    return header + bytes(records)
+
+
+def decode(clip):
+    """Yields the frames of `clip`, following the same rules as the player."""
+    if clip[:4] != MAGIC:
+        raise ValueError("not a clip")
+    rows, columns, fps, _, count, interval, _ = struct.unpack_from("<BBBBHHI", clip, 4)
+    if (rows, columns) != (ROWS, COLUMNS):
+        raise ValueError("clip of %dx%d pixels" % (rows, columns))
+    offset = 16
+    frame = bytearray(PIXELS * 3)
+    for index in range(count):
+        record_type, length = struct.unpack_from("<BH", clip, offset)
+        offset += 3
+        end = offset + length
+        if record_type not in (RECORD_KEY, RECORD_DELTA):
+            raise ValueError("frame %d: bad record" % index)
+        if index % interval == 0 and record_type != RECORD_KEY:
+            raise ValueError("frame %d should be a keyframe" % index)
+        position = 0
+        while offset < end:
+            run = clip[offset]
+            offset += 1
+            if run & RUN_REPEAT:
+                count_run = (run & 0x7F) + 1
+                frame[position * 3:(position + count_run) * 3] = clip[offset:offset + 3] * count_run
+                offset += 3
+            elif run & RUN_LITERAL:
+                count_run = (run & 0x3F) + 1
+                frame[position * 3:(position + count_run) * 3] = clip[offset:offset + count_run * 3]
+                offset += count_run * 3
+            else:
+                if record_type == RECORD_KEY:
+                    raise ValueError("frame %d: skip in a keyframe" % index)
+                count_run = (run & 0x3F) + 1
+            position += count_run
+            if position > PIXELS:
+                raise ValueError("frame %d: too many pixels" % index)
+        if offset != end or (record_type == RECORD_KEY and position != PIXELS):
+            raise ValueError("frame %d: bad length" % index)
+        yield bytes(frame)
+
+
+def upload(host, name, clip):
+    boundary = uuid.uuid4().hex
+    body = (("--%s\r\nContent-Disposition: form-data; name=\"file\"; filename=\"%s.lpc\"\r\n"
+             "Content-Type: application/octet-stream\r\n\r\n") % (boundary, name)).encode()
+    body += clip + ("\r\n--%s--\r\n" % boundary).encode()
+    request = urllib.request.Request("http://%s/clip?name=%s" % (host, name), data=body, method="POST")
+    request.add_header("Content-Type", "multipart/form-data; boundary=%s" % boundary)
+    with urllib.request.urlopen(request, timeout=30) as response:
+        return response.read().decode()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("output")
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--raw")
+    source.add_argument("--pattern", choices=("rainbow", "plasma"))
+    parser.add_argument("--fps", type=int, default=30)
+    parser.add_argument("--frames", type=int, default=300)
+    parser.add_argument("--keyframe-interval", type=int, default=30)
+    parser.add_argument("--verify", action="store_true")
+    parser.add_argument("--upload", metavar="HOST")
+    parser.add_argument("--name", default="default")
+    options = parser.parse_args()
+    if not 1 <= options.fps <= 255 or not 1 <= options.keyframe_interval <= 0xFFFF:
+        parser.error("--fps is 1..255, --keyframe-interval 1..65535")
+
+    frames = list(raw_frames(options.raw) if options.raw else pattern_frames(options.pattern, options.frames))
+    clip = encode(frames, options.fps, options.keyframe_interval)
+    with open(options.output, "wb") as output:
+        output.write(clip)
+    print("%d frames, %d bytes (%.1f%% of raw)" % (len(frames), len(clip), 100.0 * len(clip) / (len(frames) * PIXELS * 3)))
+
+    if options.verify:
+        decoded = list(decode(clip))
+        mismatches = [index for index, (a, b) in enumerate(zip(frames, decoded)) if a != b]
+        if len(decoded) != len(frames) or mismatches:
+            print("round trip FAILED: %d frames decoded, first mismatch at %s"
+                  % (len(decoded), mismatches[0] if mismatches else "-"))
+            return 1
+        print("round trip ok")
+
+    if options.upload:
+        print(upload(options.upload, options.name, clip))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
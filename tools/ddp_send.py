@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+"""Sends a test pattern to the pole over DDP (UDP 4048).
+
+    tools/ddp_send.py [host] [--fps 40] [--frames 0] [--shuffle]
+
+The pattern is a rainbow scrolling up the rows, in the sender's view of the
+pole: rows of 16 pixels from the bottom left. With --shuffle, every other
+pair of packets is swapped to exercise the out-of-order drop.
+Runs against the board or the native build (`pio run -e native -t exec`).
+"""
+import argparse
+import colorsys
+import socket
+import struct
+import time
+
+ROWS, COLUMNS = 15, 16
+PORT = 4048
+FLAGS_VERSION1, FLAGS_PUSH = 0x40, 0x01
+DATA_TYPE_RGB8 = 0x0B
+DESTINATION_DISPLAY = 1
+MAX_DATA = 480  # split the 720 bytes frame in two packets
+
+
+def frame(step):
+    pixels = bytearray()
+    for row in range(ROWS):
+        r, g, b = colorsys.hsv_to_rgb(((row + step) % ROWS) / ROWS, 1.0, 0.5)
+        pixels += bytes((int(r * 255), int(g * 255), int(b * 255))) * COLUMNS
+    return pixels
+
+
+def packets(pixels, sequence):
+    for offset in range(0, len(pixels), MAX_DATA):
+        data = pixels[offset:offset + MAX_DATA]
+        flags = FLAGS_VERSION1 | (FLAGS_PUSH if offset + len(data) == len(pixels) else 0)
+        header = struct.pack(">BBBBIH", flags, sequence, DATA_TYPE_RGB8, DESTINATION_DISPLAY, offset, len(data))
+        yield header + data
+        sequence = sequence % 15 + 1
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("host", nargs="?", default="127.0.0.1")
+    parser.add_argument("--fps", type=float, default=40)
+    parser.add_argument("--frames", type=int, default=0, help="0 runs until interrupted")
+    parser.add_argument("--shuffle", action="store_true")
+    args = parser.parse_args()
+
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sequence, step = 1, 0
+    while args.frames == 0 or step < args.frames:
+        batch = list(packets(frame(step), sequence))
+        sequence = (sequence + len(batch) - 1) % 15 + 1
+        if args.shuffle and step % 2:
+            batch.reverse()
+        for packet in batch:
+            sock.sendto(packet, (args.host, PORT))
+        step += 1
+        time.sleep(1.0 / args.fps)
+
+
+if __name__ == "__main__":
+    main()